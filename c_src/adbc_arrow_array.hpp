@@ -3,6 +3,7 @@
 #pragma once
 
 #include <stdio.h>
+#include <algorithm>
 #include <cmath>
 #include <cstdbool>
 #include <cstdint>
@@ -11,21 +12,59 @@
 #include <erl_nif.h>
 #include "adbc_half_float.hpp"
 #include "adbc_arrow_metadata.hpp"
-
-static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false);
-static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false);
+#include "adbc_arrow_decoder_plan.hpp"
+#include "adbc_civil_time.hpp"
+#include "adbc_decimal.hpp"
+
+/// How run-end encoded arrays are decoded, see `get_arrow_run_end_encoded_rows`
+enum class ArrowRunEndEncodedMode : uint8_t {
+    // `%{run_ends: column, values: column}`
+    Columns = 0,
+    // the value of every row
+    Decode,
+    // `%{run_ends: binary, values: list}`
+    Packed,
+};
+
+/// Options for decoding an ArrowArray into Erlang terms.
+struct ArrowDecodeOptions {
+    // When set, string, binary and fixed size binary values are returned as
+    // sub-binaries of one resource binary over the Arrow data buffer instead
+    // of being copied value by value. It must be the resource that owns the
+    // ArrowArray being decoded, which is then kept alive for as long as any
+    // of the returned values is referenced.
+    void * binary_owner = nullptr;
+
+    // When set, dictionary-encoded arrays are decoded into the values their
+    // indices refer to instead of `%{key: indices, value: dictionary}`.
+    bool decode_dictionary = false;
+
+    // The decoded dictionaries of the stream the (top-level) array being
+    // decoded comes from, if any. See `ArrowDictionaryCache`.
+    ArrowDictionaryCache * dictionary_cache = nullptr;
+
+    ArrowRunEndEncodedMode run_end_encoded = ArrowRunEndEncodedMode::Columns;
+
+    // When set, each list of list, large list and fixed size list arrays
+    // is decoded as a plain list of its items instead of an `%Adbc.Column{}`
+    // (unless its items are structs, maps, unions or encoded arrays).
+    bool plain_lists = false;
+};
+
+static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false, const ArrowDecoderPlan * plan = nullptr, const ArrowDecodeOptions * options = nullptr);
+static int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check = false, const ArrowDecoderPlan * plan = nullptr, const ArrowDecodeOptions * options = nullptr);
 static int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
 static int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
-static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
-static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
-static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, ArrowType list_type, unsigned n_items = 0);
-static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, unsigned n_items = 0);
-static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level);
-static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level);
+static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
+static int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error);
+static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options);
+static ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options);
+static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type, unsigned n_items = 0);
+static ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type, unsigned n_items = 0);
+static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options);
+static ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options);
+static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options);
+static ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options);
 
 template <typename M> static ERL_NIF_TERM bit_boolean_from_buffer(ErlNifEnv *env, int64_t offset, int64_t count, const uint8_t * value_buffer, const M& value_to_nif) {
     std::vector<ERL_NIF_TERM> values(count);
@@ -137,6 +176,36 @@ template <typename M, typename OffsetT> static ERL_NIF_TERM strings_from_buffer(
     return strings_from_buffer(env, 0, length, validity_bitmap, offsets_buffer, value_buffer, value_to_nif);
 }
 
+// Same as `strings_from_buffer`, but without copying: the data of all values in
+// [element_offset, element_offset + element_count) is wrapped once in a resource
+// binary owned by `owner`, and each value is a sub-binary of it.
+template <typename OffsetT> static ERL_NIF_TERM strings_from_resource_binary(
+    ErlNifEnv *env,
+    void * owner,
+    int64_t element_offset,
+    int64_t element_count,
+    const uint8_t * validity_bitmap,
+    const OffsetT * offsets_buffer,
+    const uint8_t* value_buffer) {
+    OffsetT base = offsets_buffer[element_offset];
+    OffsetT end = offsets_buffer[element_offset + element_count];
+    ERL_NIF_TERM parent = kAtomNil;
+    if (end > base) {
+        parent = enif_make_resource_binary(env, owner, value_buffer + base, (size_t)(end - base));
+    }
+    return strings_from_buffer(
+        env,
+        element_offset,
+        element_count,
+        validity_bitmap,
+        offsets_buffer,
+        value_buffer,
+        [&](ErlNifEnv *env, const uint8_t *, OffsetT offset, size_t nbytes) -> ERL_NIF_TERM {
+            return enif_make_sub_binary(env, parent, (size_t)(offset - base), nbytes);
+        }
+    );
+}
+
 template <typename M>
 static ERL_NIF_TERM fixed_size_binary_from_buffer(
     ErlNifEnv *env,
@@ -175,6 +244,35 @@ template <typename M> static ERL_NIF_TERM fixed_size_binary_from_buffer(
     return fixed_size_binary_from_buffer(env, 0, length, element_bytes, validity_bitmap, value_buffer, value_to_nif);
 }
 
+// Same as `fixed_size_binary_from_buffer`, but each value is a sub-binary of
+// one resource binary owned by `owner`, see `strings_from_resource_binary`.
+static ERL_NIF_TERM fixed_size_binary_from_resource_binary(
+    ErlNifEnv *env,
+    void * owner,
+    int64_t element_offset,
+    int64_t element_count,
+    size_t element_bytes,
+    const uint8_t * validity_bitmap,
+    const uint8_t* value_buffer) {
+    const uint8_t * start = value_buffer + element_bytes * element_offset;
+    size_t size = element_bytes * element_count;
+    ERL_NIF_TERM parent = kAtomNil;
+    if (size > 0) {
+        parent = enif_make_resource_binary(env, owner, start, size);
+    }
+    return fixed_size_binary_from_buffer(
+        env,
+        element_offset,
+        element_count,
+        element_bytes,
+        validity_bitmap,
+        value_buffer,
+        [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+            return enif_make_sub_binary(env, parent, (size_t)(val - start), element_bytes);
+        }
+    );
+}
+
 int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr, however, schema->n_children > 0");
@@ -227,7 +325,7 @@ int get_arrow_array_children_as_list(ErlNifEnv *env, struct ArrowSchema * schema
     return get_arrow_array_children_as_list(env, schema, values, 0, -1, level, children, error);
 }
 
-int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr while schema->n_children > 0");
         return 1;
@@ -248,7 +346,7 @@ int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowAr
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_array_to_nif_term(env, child_schema, child_values, offset, count, level + 1, childrens, child_type, child_metadata, error) == 1) {
+        if (arrow_array_to_nif_term(env, child_schema, child_values, offset, count, level + 1, childrens, child_type, child_metadata, error, false, &plan->children[child_i], options) == 1) {
             return 1;
         }
 
@@ -266,21 +364,21 @@ int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowAr
     return 0;
 }
 
-int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
-    return get_arrow_struct(env, schema, values, 0, -1, level, children, error);
+int get_arrow_struct(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+    return get_arrow_struct(env, schema, values, 0, -1, level, plan, options, children, error);
 }
 
 int get_arrow_dictionary(ErlNifEnv *env,
     struct ArrowSchema * index_schema, struct ArrowArray * index_array,
     struct ArrowSchema * value_schema, struct ArrowArray * value_array,
-    int64_t offset, int64_t count, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+    int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
     std::vector<ERL_NIF_TERM> keys, values;
     ERL_NIF_TERM index_type, index_metadata;
     ERL_NIF_TERM value_type, value_metadata;
-    if (arrow_array_to_nif_term(env, index_schema, index_array, offset, count, level + 1, keys, index_type, index_metadata, error, true) == 1) {
+    if (arrow_array_to_nif_term(env, index_schema, index_array, offset, count, level + 1, keys, index_type, index_metadata, error, true, plan, options) == 1) {
         return 1;
     }
-    if (arrow_array_to_nif_term(env, value_schema, value_array, offset, count, level + 1, values, value_type, value_metadata, error, false) == 1) {
+    if (arrow_array_to_nif_term(env, value_schema, value_array, offset, count, level + 1, values, value_type, value_metadata, error, false, plan->dictionary.get(), options) == 1) {
         return 1;
     }
 
@@ -300,14 +398,124 @@ int get_arrow_dictionary(ErlNifEnv *env,
     return 0;
 }
 
+// The options that change how dictionary values are decoded,
+// as part of the key of the dictionary cache
+static uint32_t get_arrow_dictionary_cache_flags(const ArrowDecodeOptions * options) {
+    return (options->decode_dictionary ? 1u : 0u)
+        | (options->plain_lists ? 2u : 0u)
+        | ((uint32_t)options->run_end_encoded << 2);
+}
+
+// Decodes the dictionary `value_array` into `{value_type, {values...}}`,
+// or takes it from the dictionary cache of the stream when there is one.
+static int get_arrow_dictionary_value_tuple(ErlNifEnv *env,
+    struct ArrowSchema * value_schema, struct ArrowArray * value_array,
+    uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ERL_NIF_TERM &out, ERL_NIF_TERM &error) {
+    ArrowDictionaryCache * cache = level == 0 ? options->dictionary_cache : nullptr;
+    const ArrowDecoderPlan * value_plan = plan->dictionary.get();
+    uint32_t flags = get_arrow_dictionary_cache_flags(options);
+    if (cache != nullptr && cache->get(env, value_plan, flags, value_array, out)) {
+        return 0;
+    }
+
+    // the values are copied, as sub-binaries of the record kept in the
+    // cache would keep the record alive for as long as the stream
+    ArrowDecodeOptions value_options = *options;
+    value_options.binary_owner = nullptr;
+
+    std::vector<ERL_NIF_TERM> values;
+    ERL_NIF_TERM value_type, value_metadata;
+    if (arrow_array_to_nif_term(env, value_schema, value_array, 0, -1, level + 1, values, value_type, value_metadata, error, false, value_plan, &value_options) == 1) {
+        return 1;
+    }
+
+    ERL_NIF_TERM list = values.size() == 1 ? values[0] : values[1];
+    std::vector<ERL_NIF_TERM> elements;
+    ERL_NIF_TERM head;
+    while (enif_get_list_cell(env, list, &head, &list)) {
+        elements.emplace_back(head);
+    }
+    out = enif_make_tuple2(env, value_type, enif_make_tuple_from_array(env, elements.data(), (unsigned)elements.size()));
+
+    if (cache != nullptr) {
+        cache->put(value_plan, flags, value_array, out);
+    }
+    return 0;
+}
+
+// Decodes a dictionary-encoded array into the values its indices refer to,
+// looking up each index in the decoded dictionary.
+//
+// `value_type` is set to the type of the dictionary values.
+int get_arrow_dictionary_values(ErlNifEnv *env,
+    struct ArrowSchema * index_schema, struct ArrowArray * index_array,
+    struct ArrowSchema * value_schema, struct ArrowArray * value_array,
+    int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ERL_NIF_TERM &out, ERL_NIF_TERM &value_type, ERL_NIF_TERM &error) {
+    ERL_NIF_TERM dictionary;
+    if (get_arrow_dictionary_value_tuple(env, value_schema, value_array, level, plan, options, dictionary, error) == 1) {
+        return 1;
+    }
+
+    int arity = 0;
+    const ERL_NIF_TERM * pair = nullptr;
+    const ERL_NIF_TERM * lookup = nullptr;
+    int n_values = 0;
+    if (!enif_get_tuple(env, dictionary, &arity, &pair) || arity != 2 || !enif_get_tuple(env, pair[1], &n_values, &lookup)) {
+        error = erlang::nif::error(env, "invalid decoded dictionary");
+        return 1;
+    }
+    value_type = pair[0];
+
+    if (index_array->n_buffers != 2) {
+        error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (dictionary indices), index_array->n_buffers != 2");
+        return 1;
+    }
+    if (count == -1) count = index_array->length;
+    if (count > index_array->length) count = index_array->length - offset;
+
+    const uint8_t * validity_bitmap = (const uint8_t *)index_array->buffers[0];
+    const void * index_buffer = index_array->buffers[1];
+    std::vector<ERL_NIF_TERM> terms(count);
+    for (int64_t i = 0; i < count; i++) {
+        int64_t j = index_array->offset + offset + i;
+        if (validity_bitmap != nullptr && !(validity_bitmap[j / 8] & (1 << (j % 8)))) {
+            terms[i] = kAtomNil;
+            continue;
+        }
+
+        int64_t index = 0;
+        switch (plan->kind) {
+            case ArrowDecoderKind::Int8: index = ((const int8_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::Int16: index = ((const int16_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::Int32: index = ((const int32_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::Int64: index = ((const int64_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::UInt8: index = ((const uint8_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::UInt16: index = ((const uint16_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::UInt32: index = ((const uint32_t *)index_buffer)[j]; break;
+            case ArrowDecoderKind::UInt64: index = (int64_t)((const uint64_t *)index_buffer)[j]; break;
+            default:
+                error = erlang::nif::error(env, "invalid ArrowArray (dictionary), indices must be integers");
+                return 1;
+        }
+        if (index < 0 || index >= n_values) {
+            error = erlang::nif::error(env, "invalid ArrowArray (dictionary), index out of range of the dictionary");
+            return 1;
+        }
+        terms[i] = lookup[index];
+    }
+
+    out = enif_make_list_from_array(env, terms.data(), (unsigned)terms.size());
+    return 0;
+}
+
 int get_arrow_dictionary(ErlNifEnv *env,
     struct ArrowSchema * index_schema, struct ArrowArray * index_array,
     struct ArrowSchema * value_schema, struct ArrowArray * value_array,
-    uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
-    return get_arrow_dictionary(env, index_schema, index_array, value_schema, value_array, 0, -1, level, children, error);
+    uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+    return get_arrow_dictionary(env, index_schema, index_array, value_schema, value_array, 0, -1, level, plan, options, children, error);
 }
 
-ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
     // From https://arrow.apache.org/docs/format/CDataInterface.html#data-type-description-format-strings
     //
     //   As specified in the Arrow columnar format, the map type has a single child type named entries,
@@ -336,18 +544,24 @@ ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * s
         return erlang::nif::error(env, "invalid ArrowSchema (map), its entries n_children != 2");
     }
 
+    const ArrowDecoderPlan * entries_plan = &plan->children[0];
+    const ArrowDecoderPlan * key_plan, * value_plan;
     struct ArrowSchema * key_schema, * value_schema;
     struct ArrowArray * key_values, * value_values;
     if (strcmp("key", entries_schema->children[0]->name) == 0 && strcmp("value", entries_schema->children[1]->name) == 0) {
         key_schema = entries_schema->children[0];
         key_values = entries_values->children[0];
+        key_plan = &entries_plan->children[0];
         value_schema = entries_schema->children[1];
         value_values = entries_values->children[1];
+        value_plan = &entries_plan->children[1];
     } else if (strcmp("key", entries_schema->children[1]->name) == 0 && strcmp("value", entries_schema->children[0]->name) == 0) {
         key_schema = entries_schema->children[1];
         key_values = entries_values->children[1];
+        key_plan = &entries_plan->children[1];
         value_schema = entries_schema->children[0];
         value_values = entries_values->children[0];
+        value_plan = &entries_plan->children[0];
     } else {
         return erlang::nif::error(env, "invalid map entries, key or value or both are missing");
     }
@@ -355,10 +569,10 @@ ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * s
     std::vector<ERL_NIF_TERM> nif_keys, nif_values;
     ERL_NIF_TERM key_type, key_metadata;
     ERL_NIF_TERM value_type, value_metadata;
-    if (arrow_array_to_nif_term(env, key_schema, key_values, offset, count, level + 1, nif_keys, key_type, key_metadata, error) == 1) {
+    if (arrow_array_to_nif_term(env, key_schema, key_values, offset, count, level + 1, nif_keys, key_type, key_metadata, error, false, key_plan, options) == 1) {
         return erlang::nif::error(env, "failed to get map keys");
     }
-    if (arrow_array_to_nif_term(env, value_schema, value_values, offset, count, level + 1, nif_values, value_type, value_metadata, error) == 1) {
+    if (arrow_array_to_nif_term(env, value_schema, value_values, offset, count, level + 1, nif_values, value_type, value_metadata, error, false, value_plan, options) == 1) {
         return erlang::nif::error(env, "failed to get map values");
     }
 
@@ -375,12 +589,135 @@ ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * s
     return map_out;
 }
 
-ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level) {
-    return get_arrow_array_map_children(env, schema, values, 0, -1, level);
+ERL_NIF_TERM get_arrow_array_map_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
+    return get_arrow_array_map_children(env, schema, values, 0, -1, level, plan, options);
 }
 
-ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+// Indices of a union child at most this many values apart are decoded in
+// the same span, as decoding the few values between them costs less than
+// another call to arrow_array_to_nif_term
+constexpr int64_t kUnionMaxSpanGap = 8;
+
+// Decodes the rows of a union given the child of every row, `child_types`,
+// and the index of its value in that child, `child_indices`. Each row is
+// `%{field_name => value}`, where `value` is the child decoded for that
+// single index.
+//
+// The rows are first grouped by child, so that each child only decodes the
+// indices used by its rows. Children decoded one term per row (see
+// `is_arrow_decoder_plan_row_wise`) decode those indices in spans of close
+// indices, and their terms are then gathered back in row order. The other
+// children, whose decoded form cannot be split by row, are decoded one index
+// at a time.
+static ERL_NIF_TERM get_arrow_union_rows(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, const std::vector<uint8_t> &child_types, const std::vector<int64_t> &child_indices, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, const char * union_name) {
     ERL_NIF_TERM error{};
+    size_t n_rows = child_types.size();
+    std::vector<ERL_NIF_TERM> elements(n_rows);
+    std::vector<ERL_NIF_TERM> field_values;
+    ERL_NIF_TERM field_type;
+    ERL_NIF_TERM field_metadata;
+    char err_msg_buf[256] = { '\0' };
+
+    // the rows of each child, in row order
+    std::vector<std::vector<size_t>> child_rows(schema->n_children);
+    for (size_t row = 0; row < n_rows; row++) {
+        child_rows[child_types[row]].emplace_back(row);
+    }
+
+    // the sorted, distinct indices used by the rows of a child,
+    // and for row-wise children the term of each of them
+    std::vector<int64_t> indices;
+    std::vector<ERL_NIF_TERM> gathered;
+    for (int64_t child_type = 0; child_type < schema->n_children; child_type++) {
+        const std::vector<size_t> &rows = child_rows[child_type];
+        if (rows.empty()) continue;
+
+        struct ArrowSchema * field_schema = schema->children[child_type];
+        struct ArrowArray * field_array = values->children[child_type];
+        const ArrowDecoderPlan * field_plan = &plan->children[child_type];
+
+        indices.clear();
+        for (size_t row : rows) {
+            indices.emplace_back(child_indices[row]);
+        }
+        if (!std::is_sorted(indices.begin(), indices.end())) {
+            std::sort(indices.begin(), indices.end());
+        }
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        if (indices.front() < 0 || indices.back() >= field_array->length) {
+            snprintf(err_msg_buf, sizeof(err_msg_buf), "invalid offset value when parsing ArrowArray (%s), out of the range of its child", union_name);
+            return erlang::nif::error(env, err_msg_buf);
+        }
+        // the key of every row of this child
+        ERL_NIF_TERM field_name = erlang::nif::make_binary(env, field_schema->name);
+        bool row_wise = is_arrow_decoder_plan_row_wise(*field_plan);
+
+        if (row_wise) {
+            gathered.clear();
+            gathered.reserve(indices.size());
+            size_t span_start = 0;
+            while (span_start < indices.size()) {
+                size_t span_end = span_start + 1;
+                while (span_end < indices.size() && indices[span_end] - indices[span_end - 1] <= kUnionMaxSpanGap) {
+                    span_end++;
+                }
+
+                int64_t first = indices[span_start];
+                field_values.clear();
+                if (arrow_array_to_nif_term(env, field_schema, field_array, first, indices[span_end - 1] - first + 1, level + 1, field_values, field_type, field_metadata, error, false, field_plan, options) == 1) {
+                    return error;
+                }
+                // keep the terms of the indices used in the span only
+                ERL_NIF_TERM head, list = field_values.size() == 1 ? field_values[0] : field_values[1];
+                int64_t index = first;
+                size_t next = span_start;
+                while (next < span_end && enif_get_list_cell(env, list, &head, &list)) {
+                    if (index == indices[next]) {
+                        gathered.emplace_back(head);
+                        next++;
+                    }
+                    index++;
+                }
+                if (next != span_end) {
+                    snprintf(err_msg_buf, sizeof(err_msg_buf), "invalid %s field value", union_name);
+                    return erlang::nif::error(env, err_msg_buf);
+                }
+                span_start = span_end;
+            }
+        }
+
+        for (size_t row : rows) {
+            ERL_NIF_TERM field_value;
+            if (row_wise) {
+                // the same as decoding this index only
+                size_t i = std::lower_bound(indices.begin(), indices.end(), child_indices[row]) - indices.begin();
+                field_value = enif_make_list1(env, gathered[i]);
+            } else {
+                field_values.clear();
+                if (arrow_array_to_nif_term(env, field_schema, field_array, child_indices[row], 1, level + 1, field_values, field_type, field_metadata, error, false, field_plan, options) == 1) {
+                    return error;
+                }
+                if (field_values.size() == 1) {
+                    field_value = field_values[0];
+                } else if (field_values.size() == 2) {
+                    field_value = field_values[1];
+                } else {
+                    snprintf(err_msg_buf, sizeof(err_msg_buf), "invalid %s field value", union_name);
+                    return erlang::nif::error(env, err_msg_buf);
+                }
+            }
+
+            if (!enif_make_map_from_arrays(env, &field_name, &field_value, 1, &elements[row])) {
+                snprintf(err_msg_buf, sizeof(err_msg_buf), "failed to enif_make_map_from_arrays when parsing ArrowSchema (%s)", union_name);
+                return erlang::nif::error(env, err_msg_buf);
+            }
+        }
+    }
+
+    return enif_make_list_from_array(env, elements.data(), (unsigned)elements.size());
+}
+
+ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (dense union), schema->children == nullptr while schema->n_children > 0 ");
     }
@@ -403,50 +740,25 @@ ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSc
     const uint8_t * types_buffer = (const uint8_t *)values->buffers[types_buffer_index];
     const int32_t * offsets_buffer = (const int32_t *)values->buffers[offset_buffer_index];
 
-    std::vector<ERL_NIF_TERM> elements(count);
+    std::vector<uint8_t> child_types(count);
+    std::vector<int64_t> child_indices(count);
     for (int64_t child_i = offset; child_i < offset + count; child_i++) {
         uint8_t child_type = types_buffer[child_i];
-        int32_t child_offset = offsets_buffer[child_i];
         if (child_type >= schema->n_children || child_type >= values->n_children) {
             return erlang::nif::error(env, "invalid child type when parsing ArrowArray (dense union), child_type >= schema->n_children || child_type >= values->n_children");
         }
-        struct ArrowSchema * field_schema = schema->children[child_type];
-        struct ArrowArray * field_array = values->children[child_type];
-
-        std::vector<ERL_NIF_TERM> union_element_name(1), union_element_value(1);
-        std::vector<ERL_NIF_TERM> field_values;
-        union_element_name[0] = erlang::nif::make_binary(env, field_schema->name);
-
-        ERL_NIF_TERM field_type;
-        ERL_NIF_TERM field_metadata;
-        if (arrow_array_to_nif_term(env, field_schema, field_array, child_offset, 1, level + 1, field_values, field_type, field_metadata, error) == 1) {
-            return error;
-        }
-
-        if (field_values.size() == 1) {
-            union_element_value[0] = field_values[0];
-        } else if (field_values.size() == 2) {
-            union_element_value[0] = field_values[1];
-        } else {
-            return erlang::nif::error(env, "invalid dense union field value");
-        }
-
-        ERL_NIF_TERM element{};
-        if (!enif_make_map_from_arrays(env, union_element_name.data(), union_element_value.data(), 1, &element)) {
-            return erlang::nif::error(env, "failed to enif_make_map_from_arrays when parsing ArrowSchema (dense union)");
-        }
-        elements[child_i - offset] = element;
+        child_types[child_i - offset] = child_type;
+        child_indices[child_i - offset] = offsets_buffer[child_i];
     }
 
-    return enif_make_list_from_array(env, elements.data(), (unsigned)elements.size());
+    return get_arrow_union_rows(env, schema, values, child_types, child_indices, level, plan, options, "dense union");
 }
 
-ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level) {
-    return get_arrow_array_dense_union_children(env, schema, values, 0, -1, level);
+ERL_NIF_TERM get_arrow_array_dense_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
+    return get_arrow_array_dense_union_children(env, schema, values, 0, -1, level, plan, options);
 }
 
-ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
-    ERL_NIF_TERM error{};
+ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (sparse union), schema->children == nullptr while schema->n_children > 0 ");
     }
@@ -467,49 +779,26 @@ ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowS
     constexpr int64_t types_buffer_index = 0;
     const uint8_t * types_buffer = (const uint8_t *)values->buffers[types_buffer_index];
 
-    std::vector<ERL_NIF_TERM> elements(count);
+    std::vector<uint8_t> child_types(count);
+    std::vector<int64_t> child_indices(count);
     for (int64_t child_i = offset; child_i < offset + count; child_i++) {
         uint8_t child_type = types_buffer[child_i];
         if (child_type >= schema->n_children || child_type >= values->n_children) {
             return erlang::nif::error(env, "invalid child type when parsing ArrowArray (sparse union), child_type >= schema->n_children || child_type >= values->n_children");
         }
-        struct ArrowSchema * field_schema = schema->children[child_type];
-        struct ArrowArray * field_array = values->children[child_type];
-
-        std::vector<ERL_NIF_TERM> union_element_name(1), union_element_value(1);
-        std::vector<ERL_NIF_TERM> field_values;
-        union_element_name[0] = erlang::nif::make_binary(env, field_schema->name);
-
-        ERL_NIF_TERM field_type;
-        // todo: use field_metadata
-        ERL_NIF_TERM field_metadata;
-        if (arrow_array_to_nif_term(env, field_schema, field_array, child_i, 1, level + 1, field_values, field_type, field_metadata, error) == 1) {
-            return error;
-        }
-
-        if (field_values.size() == 1) {
-            union_element_value[0] = field_values[0];
-        } else if (field_values.size() == 2) {
-            union_element_value[0] = field_values[1];
-        } else {
-            return erlang::nif::error(env, "invalid sparse union field value");
-        }
-
-        ERL_NIF_TERM element{};
-        if (!enif_make_map_from_arrays(env, union_element_name.data(), union_element_value.data(), 1, &element)) {
-            return erlang::nif::error(env, "failed to enif_make_map_from_arrays when parsing ArrowSchema (sparse union)");
-        }
-        elements[child_i - offset] = element;
+        // the children of a sparse union are as long as the union
+        child_types[child_i - offset] = child_type;
+        child_indices[child_i - offset] = child_i;
     }
 
-    return enif_make_list_from_array(env, elements.data(), (unsigned)elements.size());
+    return get_arrow_union_rows(env, schema, values, child_types, child_indices, level, plan, options, "sparse union");
 }
 
-ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level) {
-    return get_arrow_array_sparse_union_children(env, schema, values, 0, -1, level);
+ERL_NIF_TERM get_arrow_array_sparse_union_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
+    return get_arrow_array_sparse_union_children(env, schema, values, 0, -1, level, plan, options);
 }
 
-ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level) {
+ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
     ERL_NIF_TERM error{};
     if (schema->n_children != 2 || values->n_children != 2) {
         return erlang::nif::error(env, "invalid ArrowSchema (run_end_encoded), schema->n_children != 2 || values->n_children != 2");
@@ -529,8 +818,8 @@ ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * sche
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_array_to_nif_term(env, schema->children[child_i], values->children[child_i], 0, -1, level + 1, childrens, child_type, child_metadata, error) == 1) {
-            return 1;
+        if (arrow_array_to_nif_term(env, schema->children[child_i], values->children[child_i], 0, -1, level + 1, childrens, child_type, child_metadata, error, false, &plan->children[child_i], options) == 1) {
+            return error;
         }
 
         if (childrens.size() == 1) {
@@ -554,11 +843,238 @@ ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * sche
     return run_ends_data;
 }
 
-ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level) {
-    return get_arrow_run_end_encoded(env, schema, values, 0, -1, level);
+ERL_NIF_TERM get_arrow_run_end_encoded(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
+    return get_arrow_run_end_encoded(env, schema, values, 0, -1, level, plan, options);
+}
+
+// The run ends of `ArrowRunEndEncodedMode::Packed` are little-endian 64-bit
+// integers, like the values of packed columns
+static void put_packed_run_end(unsigned char * bytes, int64_t run_end) {
+    uint64_t value = (uint64_t)run_end;
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static int64_t get_packed_run_end(const unsigned char * bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)bytes[i] << (8 * i);
+    }
+    return (int64_t)value;
+}
+
+static int64_t arrow_run_end_at(ArrowDecoderKind kind, const void * run_ends, int64_t index) {
+    switch (kind) {
+        case ArrowDecoderKind::Int16: return ((const int16_t *)run_ends)[index];
+        case ArrowDecoderKind::Int32: return ((const int32_t *)run_ends)[index];
+        default: return ((const int64_t *)run_ends)[index];
+    }
+}
+
+// Decodes the rows [offset, offset + count) of a run-end encoded array
+// directly, instead of returning its run_ends and values columns.
+//
+// The run of the first row is found with a binary search over the run ends,
+// and only the values of the runs overlapping the rows are decoded. With
+// `ArrowRunEndEncodedMode::Decode`, `out` is the list of the value of each
+// row and `term_type` the type of the values. With `Packed`, `out` is
+// `%{run_ends: binary, values: list}`, where the run ends are little-endian
+// 64-bit integers relative to the first row and clamped to the number of rows.
+//
+// @return 0 if decoded, 1 if failed with `error` set, or -1 if the values
+// are not decoded one term per row, see `is_arrow_decoder_plan_row_wise`
+int get_arrow_run_end_encoded_rows(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ERL_NIF_TERM &out, ERL_NIF_TERM &term_type, ERL_NIF_TERM &error) {
+    if (schema->n_children != 2 || values->n_children != 2 || schema->children == nullptr || values->children == nullptr || plan->children.size() != 2) {
+        error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), expected run_ends and values children");
+        return 1;
+    }
+    const ArrowDecoderPlan &run_ends_plan = plan->children[0];
+    const ArrowDecoderPlan &values_plan = plan->children[1];
+    if (!is_arrow_decoder_plan_row_wise(values_plan)) {
+        return -1;
+    }
+
+    struct ArrowArray * run_ends_array = values->children[0];
+    struct ArrowArray * values_array = values->children[1];
+    if (run_ends_plan.kind != ArrowDecoderKind::Int16 && run_ends_plan.kind != ArrowDecoderKind::Int32 && run_ends_plan.kind != ArrowDecoderKind::Int64) {
+        error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), run ends must be 16, 32 or 64-bit integers");
+        return 1;
+    }
+    if (run_ends_array->n_buffers != 2 || run_ends_array->null_count > 0) {
+        error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), run ends must not have nulls");
+        return 1;
+    }
+
+    if (count == -1) count = values->length;
+    if (offset < 0 || count < 0 || offset + count > values->length) {
+        error = erlang::nif::error(env, "invalid offset or count value when parsing ArrowArray (run_end_encoded)");
+        return 1;
+    }
+
+    const void * run_ends = run_ends_array->buffers[1];
+    int64_t run_ends_offset = run_ends_array->offset;
+    int64_t n_runs = run_ends_array->length;
+    // logical positions of the rows, run ends include the offset of the array
+    int64_t start = values->offset + offset;
+    int64_t end = start + count;
+    if (count > 0 && (n_runs == 0 || arrow_run_end_at(run_ends_plan.kind, run_ends, run_ends_offset + n_runs - 1) < end)) {
+        error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), the last run ends before the last row");
+        return 1;
+    }
+
+    // the first run ending after `start`
+    int64_t first_run = 0, last_run = n_runs;
+    while (first_run < last_run) {
+        int64_t middle = first_run + (last_run - first_run) / 2;
+        if (arrow_run_end_at(run_ends_plan.kind, run_ends, run_ends_offset + middle) <= start) {
+            first_run = middle + 1;
+        } else {
+            last_run = middle;
+        }
+    }
+    // one past the run of the last row
+    last_run = first_run;
+    while (count > 0 && last_run < n_runs && arrow_run_end_at(run_ends_plan.kind, run_ends, run_ends_offset + last_run) < end) {
+        last_run++;
+    }
+    int64_t n_used_runs = count > 0 ? last_run - first_run + 1 : 0;
+
+    std::vector<ERL_NIF_TERM> run_values;
+    ERL_NIF_TERM values_type = kAtomNil;
+    if (n_used_runs > 0) {
+        std::vector<ERL_NIF_TERM> decoded;
+        ERL_NIF_TERM values_metadata;
+        if (arrow_array_to_nif_term(env, schema->children[1], values_array, values_array->offset + first_run, n_used_runs, level + 1, decoded, values_type, values_metadata, error, false, &values_plan, options) == 1) {
+            return 1;
+        }
+        ERL_NIF_TERM list = decoded.size() == 1 ? decoded[0] : decoded[1];
+        ERL_NIF_TERM head;
+        run_values.reserve(n_used_runs);
+        while (enif_get_list_cell(env, list, &head, &list)) {
+            run_values.emplace_back(head);
+        }
+        if ((int64_t)run_values.size() != n_used_runs) {
+            error = erlang::nif::error(env, "invalid ArrowArray (run_end_encoded), fewer values than runs");
+            return 1;
+        }
+    }
+
+    if (options->run_end_encoded == ArrowRunEndEncodedMode::Packed) {
+        ERL_NIF_TERM run_ends_term;
+        auto packed = enif_make_new_binary(env, n_used_runs * sizeof(int64_t), &run_ends_term);
+        for (int64_t i = 0; i < n_used_runs; i++) {
+            int64_t run_end = arrow_run_end_at(run_ends_plan.kind, run_ends, run_ends_offset + first_run + i);
+            put_packed_run_end(packed + i * sizeof(int64_t), (run_end < end ? run_end : end) - start);
+        }
+        ERL_NIF_TERM keys[] = { kAtomRunEnds, kAtomValues };
+        ERL_NIF_TERM data[] = { run_ends_term, enif_make_list_from_array(env, run_values.data(), (unsigned)run_values.size()) };
+        enif_make_map_from_arrays(env, keys, data, 2, &out);
+        term_type = kAdbcColumnTypeRunEndEncoded;
+        return 0;
+    }
+
+    std::vector<ERL_NIF_TERM> rows(count);
+    int64_t row = start;
+    for (int64_t i = 0; i < n_used_runs; i++) {
+        int64_t run_end = arrow_run_end_at(run_ends_plan.kind, run_ends, run_ends_offset + first_run + i);
+        if (run_end > end) run_end = end;
+        for (; row < run_end; row++) {
+            rows[row - start] = run_values[i];
+        }
+    }
+    out = enif_make_list_from_array(env, rows.data(), (unsigned)rows.size());
+    term_type = values_type;
+    return 0;
+}
+
+// Decodes the lists [offset, offset + count) of a list, large list or fixed
+// size list array whose items are decoded one term per row (see
+// `is_arrow_decoder_plan_row_wise`). The items of all the lists are decoded
+// at once, and each list is then made from a slice of them.
+static ERL_NIF_TERM get_arrow_array_flat_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type, unsigned n_items) {
+    struct ArrowSchema * items_schema = schema->children[0];
+    struct ArrowArray * items_values = values->children[0];
+    const uint8_t * bitmap_buffer = (const uint8_t *)values->buffers[0];
+    bool items_nullable = (schema->flags & ARROW_FLAG_NULLABLE) || (values->null_count > 0);
+    if (count == -1) count = values->length;
+    if (count > values->length) count = values->length - offset;
+    if (offset < 0 || count < 0) {
+        return erlang::nif::error(env, "invalid offset or count value when parsing ArrowArray (list)");
+    }
+
+    // the items of list `i` are [bounds[i], bounds[i + 1])
+    std::vector<int64_t> bounds(count + 1);
+    if (list_type == NANOARROW_TYPE_FIXED_SIZE_LIST) {
+        for (int64_t i = 0; i <= count; i++) {
+            bounds[i] = (offset + i) * n_items;
+        }
+    } else {
+        const void * offsets_ptr = (const void *)values->buffers[1];
+        if (offsets_ptr == nullptr) return erlang::nif::error(env, "invalid ArrowArray (list), offsets == nullptr");
+        auto read_bounds = [&](auto offsets) -> void {
+            for (int64_t i = 0; i <= count; i++) {
+                bounds[i] = offsets[offset + i];
+            }
+        };
+        if (list_type == NANOARROW_TYPE_LIST) {
+            read_bounds((const int32_t *)offsets_ptr);
+        } else {
+            read_bounds((const int64_t *)offsets_ptr);
+        }
+        for (int64_t i = 0; i < count; i++) {
+            if (bounds[i] > bounds[i + 1]) {
+                return erlang::nif::error(env, "invalid ArrowArray (list), offsets are not increasing");
+            }
+        }
+    }
+
+    int64_t first = bounds[0];
+    int64_t n_flat = bounds[count] - first;
+    std::vector<ERL_NIF_TERM> decoded;
+    ERL_NIF_TERM items_type, items_metadata, error;
+    if (arrow_array_to_nif_term(env, items_schema, items_values, first, n_flat, level + 1, decoded, items_type, items_metadata, error, false, &plan->children[0], options) == 1) {
+        return error;
+    }
+
+    std::vector<ERL_NIF_TERM> items;
+    items.reserve(n_flat);
+    ERL_NIF_TERM head, list = decoded.size() == 1 ? decoded[0] : decoded[1];
+    while (enif_get_list_cell(env, list, &head, &list)) {
+        items.emplace_back(head);
+    }
+    if ((int64_t)items.size() != n_flat) {
+        return erlang::nif::error(env, "invalid ArrowArray (list), fewer items than its offsets refer to");
+    }
+
+    // every list but its data is the same column, only the data is replaced
+    ERL_NIF_TERM column_template = kAtomNil;
+    bool plain_lists = options != nullptr && options->plain_lists;
+    if (!plain_lists) {
+        // Use "item" as the canonical name for list elements
+        ERL_NIF_TERM item_name_term = erlang::nif::make_binary(env, "item");
+        column_template = make_adbc_column(env, schema, values, item_name_term, items_type, items_nullable, items_metadata, kAtomNil);
+    }
+
+    std::vector<ERL_NIF_TERM> children(count);
+    for (int64_t i = 0; i < count; i++) {
+        int64_t row = offset + i;
+        if (bitmap_buffer && items_nullable && !(bitmap_buffer[row / 8] & (1 << (row % 8)))) {
+            children[i] = kAtomNil;
+            continue;
+        }
+
+        ERL_NIF_TERM row_items = enif_make_list_from_array(env, items.data() + (bounds[i] - first), (unsigned)(bounds[i + 1] - bounds[i]));
+        if (plain_lists) {
+            children[i] = row_items;
+        } else if (!enif_make_map_update(env, column_template, kAtomDataKey, row_items, &children[i])) {
+            return erlang::nif::error(env, "invalid column term");
+        }
+    }
+    return enif_make_list_from_array(env, children.data(), (unsigned)children.size());
 }
 
-ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type, unsigned n_items) {
+ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type, unsigned n_items) {
     ERL_NIF_TERM error{};
     if (schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (list), schema->children == nullptr");
@@ -580,9 +1096,13 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
     const uint8_t * bitmap_buffer = (const uint8_t *)values->buffers[bitmap_buffer_index];
     struct ArrowSchema * items_schema = schema->children[0];
     struct ArrowArray * items_values = values->children[0];
+    const ArrowDecoderPlan * items_plan = &plan->children[0];
     if (!(strcmp("item", items_schema->name) == 0 || strcmp("l", items_schema->name) == 0)) {
         return erlang::nif::error(env, "invalid ArrowSchema (list), its single child is not named `item` or `l`");
     }
+    if (is_arrow_decoder_plan_row_wise(*items_plan)) {
+        return get_arrow_array_flat_list_children(env, schema, values, offset, count, level, plan, options, list_type, n_items);
+    }
 
     std::vector<ERL_NIF_TERM> children;
     if (list_type == NANOARROW_TYPE_LIST || list_type == NANOARROW_TYPE_LARGE_LIST) {
@@ -609,7 +1129,7 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
                 std::vector<ERL_NIF_TERM> childrens;
                 ERL_NIF_TERM children_type;
                 ERL_NIF_TERM children_metadata;
-                if (arrow_array_to_nif_term(env, items_schema, items_values, offsets[i], offsets[i+1] - offsets[i], level + 1, childrens, children_type, children_metadata, error) == 1) {
+                if (arrow_array_to_nif_term(env, items_schema, items_values, offsets[i], offsets[i+1] - offsets[i], level + 1, childrens, children_type, children_metadata, error, false, items_plan, options) == 1) {
                     has_error = 1;
                     return;
                 }
@@ -655,7 +1175,7 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
             std::vector<ERL_NIF_TERM> childrens;
             ERL_NIF_TERM children_type;
             ERL_NIF_TERM children_metadata;
-            if (arrow_array_to_nif_term(env, items_schema, items_values, child_i * n_items, n_items, level + 1, childrens, children_type, children_metadata, error)) {
+            if (arrow_array_to_nif_term(env, items_schema, items_values, child_i * n_items, n_items, level + 1, childrens, children_type, children_metadata, error, false, items_plan, options)) {
                 return error;
             }
             if (childrens.size() == 1) {
@@ -674,11 +1194,11 @@ ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema *
     return enif_make_list_from_array(env, children.data(), (unsigned)children.size());
 }
 
-ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, ArrowType list_type, unsigned n_items) {
-    return get_arrow_array_list_children(env, schema, values, 0, -1, level, list_type, n_items);
+ERL_NIF_TERM get_arrow_array_list_children(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type, unsigned n_items) {
+    return get_arrow_array_list_children(env, schema, values, 0, -1, level, plan, options, list_type, n_items);
 }
 
-ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, ArrowType list_type) {
+ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type) {
     ERL_NIF_TERM error{};
     if (schema->children == nullptr) {
         return erlang::nif::error(env, "invalid ArrowSchema (list view), schema->children == nullptr");
@@ -728,7 +1248,7 @@ ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * sche
     // according to the Arrow spec, the bitmap buffer is not required for the child values
     // and this `buffer[0]` could be a random memory address, so we simply set it to nullptr here
     items_values->buffers[0] = nullptr;
-    if (arrow_array_to_nif_term(env, items_schema, items_values, 0, -1, level + 1, childrens, children_type, children_metadata, error)) {
+    if (arrow_array_to_nif_term(env, items_schema, items_values, 0, -1, level + 1, childrens, children_type, children_metadata, error, false, &plan->children[0], options)) {
         return error;
     }
     items_values->buffers[0] = bitmap_buffer;
@@ -764,11 +1284,11 @@ ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * sche
     return map_out;
 }
 
-ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, ArrowType list_type) {
-    return get_arrow_array_list_view(env, schema, values, 0, -1, level, list_type);
+ERL_NIF_TERM get_arrow_array_list_view(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options, ArrowType list_type) {
+    return get_arrow_array_list_view(env, schema, values, 0, -1, level, plan, options, list_type);
 }
 
-int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &term_type, ERL_NIF_TERM &arrow_metadata, ERL_NIF_TERM &error, bool skip_dictionary_check) {
+int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, int64_t offset, int64_t count, int64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &term_type, ERL_NIF_TERM &arrow_metadata, ERL_NIF_TERM &error, bool skip_dictionary_check, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
     if (schema == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema (nullptr) when invoking next");
         return 1;
@@ -778,11 +1298,21 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
         return 1;
     }
 
+    // callers without a cached plan (e.g. records not created from a stream)
+    // get one compiled for this call only
+    ArrowDecoderPlan compiled_plan;
+    if (plan == nullptr) {
+        compile_arrow_decoder_plan(schema, compiled_plan);
+        plan = &compiled_plan;
+    }
+    if (schema->children != nullptr && (int64_t)plan->children.size() != schema->n_children) {
+        error = erlang::nif::error(env, "invalid decoder plan, its children do not match the ArrowSchema");
+        return 1;
+    }
+
     char err_msg_buf[256] = { '\0' };
-    const char* format = schema->format ? schema->format : "";
     const char* name = schema->name ? schema->name : "";
     ERL_NIF_TERM current_term{}, children_term{};
-    size_t format_len = strlen(format);
 
     term_type = kAtomNil;
     std::vector<ERL_NIF_TERM> children;
@@ -806,7 +1336,20 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
             // points to the dictionary values array.
             term_type = kAdbcColumnTypeDictionary;
 
-            if (get_arrow_dictionary(env, schema, values, schema->dictionary, values->dictionary, offset, count, level, children, error) == 1) {
+            if (plan->dictionary == nullptr) {
+                error = erlang::nif::error(env, "invalid decoder plan, missing plan for the dictionary");
+                return 1;
+            }
+            if (options != nullptr && options->decode_dictionary) {
+                ERL_NIF_TERM data;
+                if (get_arrow_dictionary_values(env, schema, values, schema->dictionary, values->dictionary, offset, count, level, plan, options, data, term_type, error) == 1) {
+                    return 1;
+                }
+                out_terms.emplace_back(erlang::nif::make_binary(env, name));
+                out_terms.emplace_back(data);
+                return 0;
+            }
+            if (get_arrow_dictionary(env, schema, values, schema->dictionary, values->dictionary, offset, count, level, plan, options, children, error) == 1) {
                 return 1;
             }
             out_terms.emplace_back(erlang::nif::make_binary(env, name));
@@ -825,8 +1368,8 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
 
     bool is_struct = false;
     bool format_processed = true;
-    if (format_len == 1) {
-        if (format[0] == 'n') {
+    switch (plan->kind) {
+        case ArrowDecoderKind::Null: {
             term_type = kAtomNil;
             if (count == -1) count = values->length;
             if (count > values->length) count = values->length - offset;
@@ -835,7 +1378,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 nils.push_back(kAtomNil);
             }
             current_term = kAtomNil;
-        } else if (format[0] == 'l') {
+            break;
+        }
+        case ArrowDecoderKind::Int64: {
             // NANOARROW_TYPE_INT64
             using value_type = int64_t;
             term_type = kAdbcColumnTypeS64;
@@ -853,7 +1398,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
-        } else if (format[0] == 'c') {
+            break;
+        }
+        case ArrowDecoderKind::Int8: {
             // NANOARROW_TYPE_INT8
             using value_type = int8_t;
             term_type = kAdbcColumnTypeS8;
@@ -871,7 +1418,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
-        } else if (format[0] == 's') {
+            break;
+        }
+        case ArrowDecoderKind::Int16: {
             // NANOARROW_TYPE_INT16
             using value_type = int16_t;
             term_type = kAdbcColumnTypeS16;
@@ -889,7 +1438,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
-        } else if (format[0] == 'i') {
+            break;
+        }
+        case ArrowDecoderKind::Int32: {
             // NANOARROW_TYPE_INT32
             using value_type = int32_t;
             term_type = kAdbcColumnTypeS32;
@@ -907,7 +1458,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_int64
             );
-        } else if (format[0] == 'L') {
+            break;
+        }
+        case ArrowDecoderKind::UInt64: {
             // NANOARROW_TYPE_UINT64
             using value_type = uint64_t;
             term_type = kAdbcColumnTypeU64;
@@ -925,7 +1478,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
-        } else if (format[0] == 'C') {
+            break;
+        }
+        case ArrowDecoderKind::UInt8: {
             // NANOARROW_TYPE_UINT8
             using value_type = uint8_t;
             term_type = kAdbcColumnTypeU8;
@@ -943,7 +1498,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
-        } else if (format[0] == 'S') {
+            break;
+        }
+        case ArrowDecoderKind::UInt16: {
             // NANOARROW_TYPE_UINT16
             using value_type = uint16_t;
             term_type = kAdbcColumnTypeU16;
@@ -961,7 +1518,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
-        } else if (format[0] == 'I') {
+            break;
+        }
+        case ArrowDecoderKind::UInt32: {
             // NANOARROW_TYPE_UINT32
             using value_type = uint32_t;
             term_type = kAdbcColumnTypeU32;
@@ -979,7 +1538,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const value_type *)values->buffers[data_buffer_index],
                 enif_make_uint64
             );
-        } else if (format[0] == 'e') {
+            break;
+        }
+        case ArrowDecoderKind::HalfFloat: {
             // NANOARROW_TYPE_HALF_FLOAT
             using value_type = uint16_t;
             term_type = kAdbcColumnTypeF16;
@@ -1010,7 +1571,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     }
                 }
             );
-        } else if (format[0] == 'f') {
+            break;
+        }
+        case ArrowDecoderKind::Float: {
             // NANOARROW_TYPE_FLOAT
             using value_type = float;
             term_type = kAdbcColumnTypeF32;
@@ -1040,7 +1603,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     }
                 }
             );
-        } else if (format[0] == 'g') {
+            break;
+        }
+        case ArrowDecoderKind::Double: {
             // NANOARROW_TYPE_DOUBLE
             using value_type = double;
             term_type = kAdbcColumnTypeF64;
@@ -1070,7 +1635,9 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     }
                 }
             );
-        } else if (format[0] == 'b') {
+            break;
+        }
+        case ArrowDecoderKind::Bool: {
             // NANOARROW_TYPE_BOOL
             using value_type = bool;
             term_type = kAdbcColumnTypeBool;
@@ -1087,10 +1654,13 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 (const uint8_t *)values->buffers[bitmap_buffer_index],
                 (const value_type *)values->buffers[data_buffer_index]
             );
-        } else if (format[0] == 'u' || format[0] == 'z') {
+            break;
+        }
+        case ArrowDecoderKind::String:
+        case ArrowDecoderKind::Binary: {
             // NANOARROW_TYPE_BINARY
             // NANOARROW_TYPE_STRING
-            if (format[0] == 'z') {
+            if (plan->kind == ArrowDecoderKind::Binary) {
                 term_type = kAdbcColumnTypeBinary;
             } else {
                 term_type = kAdbcColumnTypeString;
@@ -1103,6 +1673,18 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=u or format=z), values->n_buffers != 3");
                 return 1;
             }
+            if (options != nullptr && options->binary_owner != nullptr) {
+                current_term = strings_from_resource_binary(
+                    env,
+                    options->binary_owner,
+                    offset,
+                    count,
+                    (const uint8_t *)values->buffers[bitmap_buffer_index],
+                    (const int32_t *)values->buffers[offset_buffer_index],
+                    (const uint8_t *)values->buffers[data_buffer_index]
+                );
+                break;
+            }
             current_term = strings_from_buffer(
                 env,
                 offset,
@@ -1114,10 +1696,13 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     return erlang::nif::make_binary(env, (const char *)(string_buffers + offset), nbytes);
                 }
             );
-        } else if (format[0] == 'U' || format[0] == 'Z') {
+            break;
+        }
+        case ArrowDecoderKind::LargeString:
+        case ArrowDecoderKind::LargeBinary: {
             // NANOARROW_TYPE_LARGE_STRING
             // NANOARROW_TYPE_LARGE_BINARY
-            if (format[0] == 'Z') {
+            if (plan->kind == ArrowDecoderKind::LargeBinary) {
                 term_type = kAdbcColumnTypeLargeBinary;
             } else {
                 term_type = kAdbcColumnTypeLargeString;
@@ -1130,6 +1715,18 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                 error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=U or format=Z), values->n_buffers != 3");
                 return 1;
             }
+            if (options != nullptr && options->binary_owner != nullptr) {
+                current_term = strings_from_resource_binary(
+                    env,
+                    options->binary_owner,
+                    offset,
+                    count,
+                    (const uint8_t *)values->buffers[bitmap_buffer_index],
+                    (const int64_t *)values->buffers[offset_buffer_index],
+                    (const uint8_t *)values->buffers[data_buffer_index]
+                );
+                break;
+            }
             current_term = strings_from_buffer(
                 env,
                 offset,
@@ -1141,556 +1738,549 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
                     return erlang::nif::make_binary(env, (const char *)(string_buffers + offset), nbytes);
                 }
             );
-        } else {
-            format_processed = false;
+            break;
         }
-    } else if (format_len == 2) {
-        if (strncmp("+s", format, 2) == 0) {
+        case ArrowDecoderKind::Struct: {
             // NANOARROW_TYPE_STRUCT
             is_struct = true;
             term_type = kAdbcColumnTypeStruct;
 
             if (count == -1) count = values->length;
             if (count > values->length) count = values->length - offset;
-            if (get_arrow_struct(env, schema, values, offset, count, level, children, error) == 1) {
+            if (get_arrow_struct(env, schema, values, offset, count, level, plan, options, children, error) == 1) {
                 return 1;
             }
             children_term = enif_make_list_from_array(env, children.data(), (unsigned)children.size());
-        } else if (strncmp("+r", format, 2) == 0) {
+            break;
+        }
+        case ArrowDecoderKind::RunEndEncoded: {
             // NANOARROW_TYPE_RUN_END_ENCODED (maybe in nanoarrow v0.6.0)
             // https://github.com/apache/arrow-nanoarrow/pull/507
             term_type = kAdbcColumnTypeRunEndEncoded;
-            children_term = get_arrow_run_end_encoded(env, schema, values, offset, count, level);
-        } else if (strncmp("+m", format, 2) == 0) {
+            if (options != nullptr && options->run_end_encoded != ArrowRunEndEncodedMode::Columns) {
+                ERL_NIF_TERM data;
+                int ret = get_arrow_run_end_encoded_rows(env, schema, values, offset, count, level, plan, options, data, term_type, error);
+                if (ret == 1) {
+                    return 1;
+                }
+                if (ret == 0) {
+                    out_terms.emplace_back(erlang::nif::make_binary(env, name));
+                    out_terms.emplace_back(data);
+                    return 0;
+                }
+            }
+            children_term = get_arrow_run_end_encoded(env, schema, values, offset, count, level, plan, options);
+            break;
+        }
+        case ArrowDecoderKind::Map: {
             // NANOARROW_TYPE_MAP
             term_type = kAdbcColumnTypeMap;
-            children_term = get_arrow_array_map_children(env, schema, values, offset, count, level);
-        } else if (strncmp("+l", format, 2) == 0) {
+            children_term = get_arrow_array_map_children(env, schema, values, offset, count, level, plan, options);
+            break;
+        }
+        case ArrowDecoderKind::List: {
             // NANOARROW_TYPE_LIST
             term_type = kAdbcColumnTypeList;
-            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST);
-        } else if (strncmp("+L", format, 2) == 0) {
+            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, plan, options, NANOARROW_TYPE_LIST);
+            break;
+        }
+        case ArrowDecoderKind::LargeList: {
             // NANOARROW_TYPE_LARGE_LIST
             term_type = kAdbcColumnTypeLargeList;
-            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST);
-        } else {
-            format_processed = false;
+            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, plan, options, NANOARROW_TYPE_LARGE_LIST);
+            break;
         }
-    } else if (format_len >= 3) {
-        // handle all formats that start with `t` (temporal types)
-        if (format[0] == 't') {
-            // formats for timestamp can be 3 or more
-            // lets handle timestamps after this `if` block
-            // (tdX, ttX, tDX and tiX are in this block)
-            if (format_len == 3) {
-                if (format[1] == 'd') {
-                    // possible format strings:
-                    // tdD - date32 [days]
-                    // tdm - date64 [milliseconds]
-                    char unit = format[2];
-
-                    if (unit == 'D' || unit == 'm') {
-                        // NANOARROW_TYPE_DATE32
-                        // NANOARROW_TYPE_DATE64
-                        ERL_NIF_TERM date_module = kAtomDateModule;
-                        ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
-                        ERL_NIF_TERM keys[] = {
-                            kAtomStructKey,
-                            kAtomCalendarKey,
-                            kAtomYearKey,
-                            kAtomMonthKey,
-                            kAtomDayKey,
-                        };
-
-                        auto convert = [unit, date_module, calendar_iso, &keys](ErlNifEnv *env, uint64_t val) -> ERL_NIF_TERM {
-                            uint64_t seconds;
-                            if (unit == 'D') {
-                                seconds = val * 24 * 60 * 60; // days
-                            } else {
-                                seconds = val / 1000; // milliseconds
-                            }
-                            time_t t = (time_t)seconds;
-                            tm* time = gmtime(&t);
-                            ERL_NIF_TERM ex_date;
-                            ERL_NIF_TERM values[] = {
-                                date_module,
-                                calendar_iso,
-                                enif_make_int(env, time->tm_year + 1900),
-                                enif_make_int(env, time->tm_mon + 1),
-                                enif_make_int(env, time->tm_mday)
-                            };
-                            enif_make_map_from_arrays(env, keys, values, 5, &ex_date);
-                            return ex_date;
-                        };
-                        if (unit == 'D') {
-                            using value_type = uint32_t;
-                            term_type = kAdbcColumnTypeDate32;
-                            if (count == -1) count = values->length;
-                            if (count > values->length) count = values->length - offset;
-                            if (values->n_buffers != 2) {
-                                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tdD), values->n_buffers != 2");
-                                return 1;
-                            }
-                            current_term = values_from_buffer(
-                                env,
-                                offset,
-                                count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
-                                (const value_type *)values->buffers[data_buffer_index],
-                                convert
-                            );
-                        } else {
-                            using value_type = uint64_t;
-                            term_type = kAdbcColumnTypeDate64;
-                            if (count == -1) count = values->length;
-                            if (count > values->length) count = values->length - offset;
-                            if (values->n_buffers != 2) {
-                                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tdm), values->n_buffers != 2");
-                                return 1;
-                            }
-                            current_term = values_from_buffer(
-                                env,
-                                offset,
-                                count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
-                                (const value_type *)values->buffers[data_buffer_index],
-                                convert
-                            );
-                        }
-                    } else {
-                        format_processed = false;
-                    }
-                // time
-                } else if (format[1] == 't') {
-                    // possible format strings:
-                    // tts - time32 [seconds]
-                    // ttm - time32 [milliseconds]
-                    // ttu - time64 [microseconds]
-                    // ttn - time64 [nanoseconds]
-                    uint64_t unit;
-                    uint8_t us_precision;
-                    switch (format[2]) {
-                        case 's': // seconds
-                            // NANOARROW_TYPE_TIME32
-                            unit = 1000000000;
-                            us_precision = 0;
-                            term_type = kAdbcColumnTypeTime32Seconds;
-                            break;
-                        case 'm': // milliseconds
-                            // NANOARROW_TYPE_TIME32
-                            unit = 1000000;
-                            us_precision = 3;
-                            term_type = kAdbcColumnTypeTime32Milliseconds;
-                            break;
-                        case 'u': // microseconds
-                            // NANOARROW_TYPE_TIME64
-                            unit = 1000;
-                            us_precision = 6;
-                            term_type = kAdbcColumnTypeTime64Microseconds;
-                            break;
-                        case 'n': // nanoseconds
-                            // NANOARROW_TYPE_TIME64
-                            unit = 1;
-                            us_precision = 6;
-                            term_type = kAdbcColumnTypeTime64Nanoseconds;
-                            break;
-                        default:
-                            format_processed = false;
-                    }
+        case ArrowDecoderKind::Date32:
+        case ArrowDecoderKind::Date64: {
+            // NANOARROW_TYPE_DATE32
+            // NANOARROW_TYPE_DATE64
+            char unit = plan->unit;
+            ERL_NIF_TERM date_module = kAtomDateModule;
+            ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
+            ERL_NIF_TERM keys[] = {
+                kAtomStructKey,
+                kAtomCalendarKey,
+                kAtomYearKey,
+                kAtomMonthKey,
+                kAtomDayKey,
+            };
+
+            auto convert = [unit, date_module, calendar_iso, &keys](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+                int64_t days;
+                if (unit == 'D') {
+                    days = val; // days
+                } else {
+                    days = civil_floor_div(val, kSecondsPerDay * 1000); // milliseconds
+                }
+                CivilDate date = civil_from_days(days);
+                ERL_NIF_TERM ex_date;
+                ERL_NIF_TERM values[] = {
+                    date_module,
+                    calendar_iso,
+                    enif_make_int64(env, date.year),
+                    enif_make_uint(env, date.month),
+                    enif_make_uint(env, date.day)
+                };
+                enif_make_map_from_arrays(env, keys, values, 5, &ex_date);
+                return ex_date;
+            };
+            if (unit == 'D') {
+                using value_type = int32_t;
+                term_type = kAdbcColumnTypeDate32;
+                if (count == -1) count = values->length;
+                if (count > values->length) count = values->length - offset;
+                if (values->n_buffers != 2) {
+                    error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tdD), values->n_buffers != 2");
+                    return 1;
+                }
+                current_term = values_from_buffer(
+                    env,
+                    offset,
+                    count,
+                    (const uint8_t *)values->buffers[bitmap_buffer_index],
+                    (const value_type *)values->buffers[data_buffer_index],
+                    convert
+                );
+            } else {
+                using value_type = int64_t;
+                term_type = kAdbcColumnTypeDate64;
+                if (count == -1) count = values->length;
+                if (count > values->length) count = values->length - offset;
+                if (values->n_buffers != 2) {
+                    error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tdm), values->n_buffers != 2");
+                    return 1;
+                }
+                current_term = values_from_buffer(
+                    env,
+                    offset,
+                    count,
+                    (const uint8_t *)values->buffers[bitmap_buffer_index],
+                    (const value_type *)values->buffers[data_buffer_index],
+                    convert
+                );
+            }
+            break;
+        }
+        case ArrowDecoderKind::Time: {
+            // possible format strings:
+            // tts - time32 [seconds]
+            // ttm - time32 [milliseconds]
+            // ttu - time64 [microseconds]
+            // ttn - time64 [nanoseconds]
+            char unit = plan->unit;
+            uint8_t us_precision;
+            switch (unit) {
+                case 's': // seconds
+                    // NANOARROW_TYPE_TIME32
+                    us_precision = 0;
+                    term_type = kAdbcColumnTypeTime32Seconds;
+                    break;
+                case 'm': // milliseconds
+                    // NANOARROW_TYPE_TIME32
+                    us_precision = 3;
+                    term_type = kAdbcColumnTypeTime32Milliseconds;
+                    break;
+                case 'u': // microseconds
+                    // NANOARROW_TYPE_TIME64
+                    us_precision = 6;
+                    term_type = kAdbcColumnTypeTime64Microseconds;
+                    break;
+                default: // nanoseconds
+                    // NANOARROW_TYPE_TIME64
+                    us_precision = 6;
+                    term_type = kAdbcColumnTypeTime64Nanoseconds;
+                    break;
+            }
 
-                    if (format_processed) {
-                        using value_type = uint64_t;
-                        if (count == -1) count = values->length;
-                        if (count > values->length) count = values->length - offset;
-                        if (values->n_buffers != 2) {
-                            error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tt), values->n_buffers != 2");
-                            return 1;
-                        }
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tt), values->n_buffers != 2");
+                return 1;
+            }
 
-                        ERL_NIF_TERM keys[] = {
-                            kAtomStructKey,
-                            kAtomCalendarKey,
-                            kAtomHourKey,
-                            kAtomMinuteKey,
-                            kAtomSecondKey,
-                            kAtomMicrosecondKey,
-                        };
-
-                        ERL_NIF_TERM time_module = kAtomTimeModule;
-                        ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
-
-                        current_term = values_from_buffer(
-                            env,
-                            offset,
-                            count,
-                            (const uint8_t *)values->buffers[bitmap_buffer_index],
-                            (const value_type *)values->buffers[data_buffer_index],
-                            [unit, us_precision, time_module, calendar_iso, &keys](ErlNifEnv *env, uint64_t val) -> ERL_NIF_TERM {
-                                // Elixir only supports microsecond precision
-                                uint64_t us = val * unit / 1000;
-                                time_t s = (time_t)(us / 1000000);
-                                tm* time = gmtime(&s);
-                                us = us % 1000000;
-
-                                ERL_NIF_TERM ex_time;
-                                ERL_NIF_TERM values[] = {
-                                    time_module,
-                                    calendar_iso,
-                                    enif_make_int(env, time->tm_hour),
-                                    enif_make_int(env, time->tm_min),
-                                    enif_make_int(env, time->tm_sec),
-                                    enif_make_tuple2(env, enif_make_int(env, us), enif_make_int(env, us_precision))
-                                };
-                                enif_make_map_from_arrays(env, keys, values, 6, &ex_time);
-                                return ex_time;
-                            }
-                    );
-                    }
-                // timestamp
-                } else if (format[1] == 'D') {
-                    // possible format strings:
-                    // tDs - duration [seconds]
-                    // tDm - duration [milliseconds]
-                    // tDu - duration [microseconds]
-                    // tDn - duration [nanoseconds]
-
-                    // NANOARROW_TYPE_DURATION
-                    switch (format[2]) {
-                        case 's': // seconds
-                            term_type = kAdbcColumnTypeDurationSeconds;
-                            break;
-                        case 'm': // milliseconds
-                            term_type = kAdbcColumnTypeDurationMilliseconds;
-                            break;
-                        case 'u': // microseconds
-                            term_type = kAdbcColumnTypeDurationMicroseconds;
-                            break;
-                        case 'n': // nanoseconds
-                            term_type = kAdbcColumnTypeDurationNanoseconds;
-                            break;
-                        default:
-                            format_processed = false;
-                    }
+            ERL_NIF_TERM keys[] = {
+                kAtomStructKey,
+                kAtomCalendarKey,
+                kAtomHourKey,
+                kAtomMinuteKey,
+                kAtomSecondKey,
+                kAtomMicrosecondKey,
+            };
+
+            ERL_NIF_TERM time_module = kAtomTimeModule;
+            ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
+
+            auto convert = [unit, us_precision, time_module, calendar_iso, &keys](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+                // Elixir only supports microsecond precision
+                CivilTime time = civil_time_from_microseconds(civil_microseconds_from_unit(val, unit));
+
+                ERL_NIF_TERM ex_time;
+                ERL_NIF_TERM values[] = {
+                    time_module,
+                    calendar_iso,
+                    enif_make_uint(env, time.hour),
+                    enif_make_uint(env, time.minute),
+                    enif_make_uint(env, time.second),
+                    enif_make_tuple2(env, enif_make_uint(env, time.microsecond), enif_make_int(env, us_precision))
+                };
+                enif_make_map_from_arrays(env, keys, values, 6, &ex_time);
+                return ex_time;
+            };
+            if (unit == 's' || unit == 'm') {
+                // time32 values are 32-bit
+                current_term = values_from_buffer(
+                    env,
+                    offset,
+                    count,
+                    (const uint8_t *)values->buffers[bitmap_buffer_index],
+                    (const int32_t *)values->buffers[data_buffer_index],
+                    convert
+                );
+            } else {
+                current_term = values_from_buffer(
+                    env,
+                    offset,
+                    count,
+                    (const uint8_t *)values->buffers[bitmap_buffer_index],
+                    (const int64_t *)values->buffers[data_buffer_index],
+                    convert
+                );
+            }
+            break;
+        }
+        case ArrowDecoderKind::Duration: {
+            // possible format strings:
+            // tDs - duration [seconds]
+            // tDm - duration [milliseconds]
+            // tDu - duration [microseconds]
+            // tDn - duration [nanoseconds]
+
+            // NANOARROW_TYPE_DURATION
+            switch (plan->unit) {
+                case 's': // seconds
+                    term_type = kAdbcColumnTypeDurationSeconds;
+                    break;
+                case 'm': // milliseconds
+                    term_type = kAdbcColumnTypeDurationMilliseconds;
+                    break;
+                case 'u': // microseconds
+                    term_type = kAdbcColumnTypeDurationMicroseconds;
+                    break;
+                default: // nanoseconds
+                    term_type = kAdbcColumnTypeDurationNanoseconds;
+                    break;
+            }
 
-                    if (format_processed) {
-                        using value_type = int64_t;
-                        if (count == -1) count = values->length;
-                        if (count > values->length) count = values->length - offset;
-                        if (values->n_buffers != 2) {
-                            error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tD), values->n_buffers != 2");
-                            return 1;
-                        }
+            using value_type = int64_t;
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tD), values->n_buffers != 2");
+                return 1;
+            }
 
-                        current_term = values_from_buffer(
-                            env,
-                            offset,
-                            count,
-                            (const uint8_t *)values->buffers[bitmap_buffer_index],
-                            (const value_type *)values->buffers[data_buffer_index],
-                            enif_make_int64
-                        );
-                    }
-                } else if (format[1] == 'i') {
-                    // possible format strings:
-                    // tiM - interval [months]
-                    // tiD - interval [days, time]
-                    // tin - interval [month, day, nanoseconds]
-
-                    // NANOARROW_TYPE_INTERVAL
-                    switch (format[2]) {
-                        case 'M': // months
-                            term_type = kAdbcColumnTypeIntervalMonth;
-                            break;
-                        case 'D': // days, time
-                            term_type = kAdbcColumnTypeIntervalDayTime;
-                            break;
-                        case 'n': // month, day, nanoseconds
-                            term_type = kAdbcColumnTypeIntervalMonthDayNano;
-                            break;
-                        default:
-                            format_processed = false;
-                    }
+            current_term = values_from_buffer(
+                env,
+                offset,
+                count,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const value_type *)values->buffers[data_buffer_index],
+                enif_make_int64
+            );
+            break;
+        }
+        case ArrowDecoderKind::IntervalMonth: {
+            // NANOARROW_TYPE_INTERVAL
+            using value_type = int32_t;
+            term_type = kAdbcColumnTypeIntervalMonth;
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tiM), values->n_buffers != 2");
+                return 1;
+            }
 
-                    if (format_processed) {
-                        if (format[2] == 'M') {
-                            using value_type = int32_t;
-                            if (count == -1) count = values->length;
-                            if (count > values->length) count = values->length - offset;
-                            if (values->n_buffers != 2) {
-                                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tiM), values->n_buffers != 2");
-                                return 1;
-                            }
-
-                            current_term = values_from_buffer(
-                                env,
-                                offset,
-                                count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
-                                (const value_type *)values->buffers[data_buffer_index],
-                                enif_make_int64
-                            );
-                        } else if (format[2] == 'D') {
-                            using value_type = int64_t;
-                            if (count == -1) count = values->length;
-                            if (count > values->length) count = values->length - offset;
-                            if (values->n_buffers != 2) {
-                                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tiD), values->n_buffers != 2");
-                                return 1;
-                            }
-
-                            current_term = values_from_buffer(
-                                env,
-                                offset,
-                                count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
-                                (const value_type *)values->buffers[data_buffer_index],
-                                [](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
-                                    int32_t days = val & 0xFFFFFFFF;
-                                    int32_t time = val >> 32;
-                                    return enif_make_tuple2(env, enif_make_int(env, days), enif_make_int(env, time));
-                                }
-                            );
-                        } else {
-                            using value_type = struct {
-                                int64_t data[2];
-                            };
-                            if (count == -1) count = values->length;
-                            if (count > values->length) count = values->length - offset;
-                            if (values->n_buffers != 2) {
-                                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tin), values->n_buffers != 2");
-                                return 1;
-                            }
-
-                            current_term = values_from_buffer(
-                                env,
-                                offset,
-                                count,
-                                (const uint8_t *)values->buffers[bitmap_buffer_index],
-                                (const value_type *)values->buffers[data_buffer_index],
-                                [](ErlNifEnv *env, value_type val) -> ERL_NIF_TERM {
-                                    int32_t months = val.data[0] & 0xFFFFFFFF;
-                                    int32_t days = val.data[0] >> 32;
-                                    return enif_make_tuple3(env, enif_make_int64(env, months), enif_make_int64(env, days), enif_make_int64(env, val.data[1]));
-                                }
-                            );
-                        }
-                    }
-                } else {
-                    format_processed = false;
+            current_term = values_from_buffer(
+                env,
+                offset,
+                count,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const value_type *)values->buffers[data_buffer_index],
+                enif_make_int64
+            );
+            break;
+        }
+        case ArrowDecoderKind::IntervalDayTime: {
+            // NANOARROW_TYPE_INTERVAL
+            using value_type = int64_t;
+            term_type = kAdbcColumnTypeIntervalDayTime;
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tiD), values->n_buffers != 2");
+                return 1;
+            }
+
+            current_term = values_from_buffer(
+                env,
+                offset,
+                count,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const value_type *)values->buffers[data_buffer_index],
+                [](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+                    int32_t days = val & 0xFFFFFFFF;
+                    int32_t time = val >> 32;
+                    return enif_make_tuple2(env, enif_make_int(env, days), enif_make_int(env, time));
                 }
-            } else if (format_len >= 4 && format[1] == 's' && format[3] == ':') {
-                // according to the arrow spec:
-                //   The timezone string is appended as-is after the colon character :,
-                //   without any quotes. If the timezone is empty, the colon : must still be included.
-                // so the format length for timestamps must be >= 4
-
-                // possible format strings:
-                // tss: - timestamp [seconds]
-                // tsm: - timestamp [milliseconds]
-                // tsu: - timestamp [microseconds]
-                // tsn: - timestamp [nanoseconds]
-                //
-                // if there're any timezone infomation
-                // it should be in the format like `tsu:timezone`
-
-                // NANOARROW_TYPE_TIMESTAMP
-                uint64_t unit;
-                uint8_t us_precision;
-                ERL_NIF_TERM term_unit;
-                ERL_NIF_TERM term_timezone = kAtomNil;
-                switch (format[2]) {
-                    case 's': // seconds
-                        unit = 1000000000;
-                        us_precision = 0;
-                        term_unit = kAtomSeconds;
-                        break;
-                    case 'm': // milliseconds
-                        unit = 1000000;
-                        us_precision = 3;
-                        term_unit = kAtomMilliseconds;
-                        break;
-                    case 'u': // microseconds
-                        unit = 1000;
-                        us_precision = 6;
-                        term_unit = kAtomMicroseconds;
-                        break;
-                    case 'n': // nanoseconds
-                        unit = 1;
-                        us_precision = 6;
-                        term_unit = kAtomNanoseconds;
-                        break;
-                    default:
-                        format_processed = false;
+            );
+            break;
+        }
+        case ArrowDecoderKind::IntervalMonthDayNano: {
+            // NANOARROW_TYPE_INTERVAL
+            using value_type = struct {
+                int64_t data[2];
+            };
+            term_type = kAdbcColumnTypeIntervalMonthDayNano;
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=tin), values->n_buffers != 2");
+                return 1;
+            }
+
+            current_term = values_from_buffer(
+                env,
+                offset,
+                count,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const value_type *)values->buffers[data_buffer_index],
+                [](ErlNifEnv *env, value_type val) -> ERL_NIF_TERM {
+                    int32_t months = val.data[0] & 0xFFFFFFFF;
+                    int32_t days = val.data[0] >> 32;
+                    return enif_make_tuple3(env, enif_make_int64(env, months), enif_make_int64(env, days), enif_make_int64(env, val.data[1]));
                 }
+            );
+            break;
+        }
+        case ArrowDecoderKind::Timestamp: {
+            // possible format strings:
+            // tss: - timestamp [seconds]
+            // tsm: - timestamp [milliseconds]
+            // tsu: - timestamp [microseconds]
+            // tsn: - timestamp [nanoseconds]
+            //
+            // if there're any timezone infomation
+            // it should be in the format like `tsu:timezone`
+
+            // NANOARROW_TYPE_TIMESTAMP
+            char unit = plan->unit;
+            uint8_t us_precision;
+            ERL_NIF_TERM term_unit;
+            ERL_NIF_TERM term_timezone = kAtomNil;
+            switch (unit) {
+                case 's': // seconds
+                    us_precision = 0;
+                    term_unit = kAtomSeconds;
+                    break;
+                case 'm': // milliseconds
+                    us_precision = 3;
+                    term_unit = kAtomMilliseconds;
+                    break;
+                case 'u': // microseconds
+                    us_precision = 6;
+                    term_unit = kAtomMicroseconds;
+                    break;
+                default: // nanoseconds
+                    us_precision = 6;
+                    term_unit = kAtomNanoseconds;
+                    break;
+            }
 
-                if (format_processed) {
-                    if (format_len > 4 && format[3] == ':') {
-                        std::string timezone(&format[4]);
-                        term_timezone = erlang::nif::make_binary(env, timezone);
-                    }
-                    term_type = enif_make_tuple3(env, kAtomTimestamp, term_unit, term_timezone);
-
-                    using value_type = int64_t;
-                    if (count == -1) count = values->length;
-                    if (count > values->length) count = values->length - offset;
-                    if (values->n_buffers != 2) {
-                        error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=ts), values->n_buffers != 2");
-                        return 1;
-                    }
+            if (plan->has_timezone) {
+                term_timezone = erlang::nif::make_binary(env, plan->timezone);
+            }
+            term_type = enif_make_tuple3(env, kAtomTimestamp, term_unit, term_timezone);
 
-                    ERL_NIF_TERM naive_dt_module = kAtomNaiveDateTimeModule;
-                    ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
-
-                    ERL_NIF_TERM keys[] = {
-                        kAtomStructKey,
-                        kAtomCalendarKey,
-                        kAtomYearKey,
-                        kAtomMonthKey,
-                        kAtomDayKey,
-                        kAtomHourKey,
-                        kAtomMinuteKey,
-                        kAtomSecondKey,
-                        kAtomMicrosecondKey,
+            using value_type = int64_t;
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                error = erlang::nif::error(env, "invalid n_buffers value for ArrowArray (format=ts), values->n_buffers != 2");
+                return 1;
+            }
+
+            ERL_NIF_TERM naive_dt_module = kAtomNaiveDateTimeModule;
+            ERL_NIF_TERM calendar_iso = kAtomCalendarISO;
+
+            ERL_NIF_TERM keys[] = {
+                kAtomStructKey,
+                kAtomCalendarKey,
+                kAtomYearKey,
+                kAtomMonthKey,
+                kAtomDayKey,
+                kAtomHourKey,
+                kAtomMinuteKey,
+                kAtomSecondKey,
+                kAtomMicrosecondKey,
+            };
+
+            current_term = values_from_buffer(
+                env,
+                offset,
+                count,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const value_type *)values->buffers[data_buffer_index],
+                [unit, us_precision, naive_dt_module, calendar_iso, &keys](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
+                    // Elixir only supports microsecond precision
+                    int64_t us = civil_microseconds_from_unit(val, unit);
+                    CivilDate date = civil_from_days(civil_floor_div(us, kMicrosecondsPerDay));
+                    CivilTime time = civil_time_from_microseconds(us);
+
+                    ERL_NIF_TERM ex_dt;
+                    ERL_NIF_TERM values[] = {
+                        naive_dt_module,
+                        calendar_iso,
+                        enif_make_int64(env, date.year),
+                        enif_make_uint(env, date.month),
+                        enif_make_uint(env, date.day),
+                        enif_make_uint(env, time.hour),
+                        enif_make_uint(env, time.minute),
+                        enif_make_uint(env, time.second),
+                        enif_make_tuple2(env, enif_make_uint(env, time.microsecond), enif_make_int(env, us_precision))
                     };
 
-                    current_term = values_from_buffer(
-                        env,
-                        offset,
-                        count,
-                        (const uint8_t *)values->buffers[bitmap_buffer_index],
-                        (const value_type *)values->buffers[data_buffer_index],
-                        [unit, us_precision, naive_dt_module, calendar_iso, &keys](ErlNifEnv *env, int64_t val) -> ERL_NIF_TERM {
-                            // Elixir only supports microsecond precision
-                            int64_t us = val * unit / 1000;
-                            time_t t = (time_t)(us / 1000000);
-                            tm* time = gmtime(&t);
-                            us = us % 1000000;
-
-                            ERL_NIF_TERM ex_dt;
-                            ERL_NIF_TERM values[] = {
-                                naive_dt_module,
-                                calendar_iso,
-                                enif_make_int(env, time->tm_year + 1900),
-                                enif_make_int(env, time->tm_mon + 1),
-                                enif_make_int(env, time->tm_mday),
-                                enif_make_int(env, time->tm_hour),
-                                enif_make_int(env, time->tm_min),
-                                enif_make_int(env, time->tm_sec),
-                                enif_make_tuple2(env, enif_make_int(env, us), enif_make_int(env, us_precision))
-                            };
-
-                            enif_make_map_from_arrays(env, keys, values, 9, &ex_dt);
-                            return ex_dt;
-                        }
-                    );
+                    enif_make_map_from_arrays(env, keys, values, 9, &ex_dt);
+                    return ex_dt;
                 }
-            } else {
-                format_processed = false;
+            );
+            break;
+        }
+        case ArrowDecoderKind::ListView: {
+            // NANOARROW_TYPE_LIST(VIEW)
+            term_type = kAdbcColumnTypeListView;
+            children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, plan, options, NANOARROW_TYPE_LIST);
+            break;
+        }
+        case ArrowDecoderKind::LargeListView: {
+            // NANOARROW_TYPE_LARGE_LIST(VIEW)
+            term_type = kAdbcColumnTypeLargeListView;
+            children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, plan, options, NANOARROW_TYPE_LARGE_LIST);
+            break;
+        }
+        case ArrowDecoderKind::FixedSizeList: {
+            // NANOARROW_TYPE_FIXED_SIZE_LIST
+            unsigned n_items = (unsigned)plan->fixed_size;
+            term_type = kAdbcColumnTypeFixedSizeList(n_items);
+            children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, plan, options, NANOARROW_TYPE_FIXED_SIZE_LIST, n_items);
+            break;
+        }
+        case ArrowDecoderKind::FixedSizeBinary: {
+            // NANOARROW_TYPE_FIXED_SIZE_BINARY
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                snprintf(err_msg_buf, 255, "invalid n_buffers value for ArrowArray (format=%s), values->n_buffers != 2", schema->format);
+                error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
+                return 1;
             }
-        } else {
-            if (format_len == 3 && strncmp("+vl", format, 3) == 0) {
-                // NANOARROW_TYPE_LIST(VIEW)
-                term_type = kAdbcColumnTypeListView;
-                children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, NANOARROW_TYPE_LIST);
-            } else if (format_len == 3 && strncmp("+vL", format, 3) == 0) {
-                // NANOARROW_TYPE_LARGE_LIST(VIEW)
-                term_type = kAdbcColumnTypeLargeListView;
-                children_term = get_arrow_array_list_view(env, schema, values, offset, count, level, NANOARROW_TYPE_LARGE_LIST);
-            } else if (strncmp("+w:", format, 3) == 0) {
-                // NANOARROW_TYPE_FIXED_SIZE_LIST
-                unsigned n_items = 0;
-                for (size_t i = 3; i < format_len; i++) {
-                    n_items = n_items * 10 + (format[i] - '0');
-                }
-                term_type = kAdbcColumnTypeFixedSizeList(n_items);
-                children_term = get_arrow_array_list_children(env, schema, values, offset, count, level, NANOARROW_TYPE_FIXED_SIZE_LIST, n_items);
-            } else if (strncmp("w:", format, 2) == 0) {
-                // NANOARROW_TYPE_FIXED_SIZE_BINARY
-                if (count == -1) count = values->length;
-                if (count > values->length) count = values->length - offset;
-                if (values->n_buffers != 2) {
-                    snprintf(err_msg_buf, 255, "invalid n_buffers value for ArrowArray (format=%s), values->n_buffers != 2", schema->format);
-                    error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
-                    return 1;
-                }
-                size_t nbytes = 0;
-                for (size_t i = 2; i < format_len; i++) {
-                    nbytes = nbytes * 10 + (format[i] - '0');
-                }
-                term_type = kAdbcColumnTypeFixedSizeBinary(nbytes);
-                current_term = fixed_size_binary_from_buffer(
+            size_t nbytes = (size_t)plan->fixed_size;
+            term_type = kAdbcColumnTypeFixedSizeBinary(nbytes);
+            if (options != nullptr && options->binary_owner != nullptr) {
+                current_term = fixed_size_binary_from_resource_binary(
                     env,
+                    options->binary_owner,
                     offset,
                     count,
                     nbytes,
                     (const uint8_t *)values->buffers[bitmap_buffer_index],
-                    (const uint8_t *)values->buffers[data_buffer_index],
-                    [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
-                        return erlang::nif::make_binary(env, (const char *)val, nbytes);
-                    }
+                    (const uint8_t *)values->buffers[data_buffer_index]
                 );
-            } else if (format_len > 4 && (strncmp("+ud:", format, 4) == 0)) {
-                // NANOARROW_TYPE_DENSE_UNION
-                term_type = kAdbcColumnTypeDenseUnion;
-                children_term = get_arrow_array_dense_union_children(env, schema, values, offset, count, level);
-            } else if (format_len > 4 && (strncmp("+us:", format, 4) == 0)) {
-                // NANOARROW_TYPE_SPARSE_UNION
-                term_type = kAdbcColumnTypeSparseUnion;
-                children_term = get_arrow_array_sparse_union_children(env, schema, values, offset, count, level);
-            } else if (strncmp("d:", format, 2) == 0) {
-                // NANOARROW_TYPE_DECIMAL128
-                // NANOARROW_TYPE_DECIMAL256
-                //
-                // format should match `d:P,S[,N]`
-                // where P is precision, S is scale, N is bits
-                // N is optional and defaults to 128
-                int precision = 0;
-                int scale = 0;
-                int bits = 0;
-                int * d[3] = {&precision, &scale, &bits};
-                int index = 0;
-                for (size_t i = 2; i < format_len; i++) {
-                    if (format[i] == ',') {
-                        if (index < 2) {
-                            index++;
-                        } else {
-                            format_processed = false;
-                            break;
-                        }
-                        continue;
-                    }
-
-                    *d[index] = *d[index] * 10 + (format[i] - '0');
+                break;
+            }
+            current_term = fixed_size_binary_from_buffer(
+                env,
+                offset,
+                count,
+                nbytes,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const uint8_t *)values->buffers[data_buffer_index],
+                [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+                    return erlang::nif::make_binary(env, (const char *)val, nbytes);
                 }
-
-                if (format_processed) {
-                    if (bits == 0) bits = 128;
-                    term_type = kAdbcColumnTypeDecimal(bits, precision, scale);
-                    if (count == -1) count = values->length;
-                    if (count > values->length) count = values->length - offset;
-                    if (values->n_buffers != 2) {
-                        snprintf(err_msg_buf, 255, "invalid n_buffers value for ArrowArray (format=%s), values->n_buffers != 2", schema->format);
-                        error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
-                        return 1;
+            );
+            break;
+        }
+        case ArrowDecoderKind::DenseUnion: {
+            // NANOARROW_TYPE_DENSE_UNION
+            term_type = kAdbcColumnTypeDenseUnion;
+            children_term = get_arrow_array_dense_union_children(env, schema, values, offset, count, level, plan, options);
+            break;
+        }
+        case ArrowDecoderKind::SparseUnion: {
+            // NANOARROW_TYPE_SPARSE_UNION
+            term_type = kAdbcColumnTypeSparseUnion;
+            children_term = get_arrow_array_sparse_union_children(env, schema, values, offset, count, level, plan, options);
+            break;
+        }
+        case ArrowDecoderKind::Decimal: {
+            // NANOARROW_TYPE_DECIMAL128
+            // NANOARROW_TYPE_DECIMAL256
+            int bits = plan->bits;
+            term_type = kAdbcColumnTypeDecimal(bits, plan->precision, plan->scale);
+            if (count == -1) count = values->length;
+            if (count > values->length) count = values->length - offset;
+            if (values->n_buffers != 2) {
+                snprintf(err_msg_buf, 255, "invalid n_buffers value for ArrowArray (format=%s), values->n_buffers != 2", schema->format);
+                error = erlang::nif::error(env, erlang::nif::make_binary(env, err_msg_buf));
+                return 1;
+            }
+            // the values are made into `%Decimal{}` structs directly, sharing
+            // the terms that are the same for every value of the column
+            int nlimbs = bits / 64;
+            bool coefficient_failed = false;
+            ERL_NIF_TERM keys[] = {
+                kAtomStructKey,
+                kAtomSignKey,
+                kAtomCoefKey,
+                kAtomExpKey,
+            };
+            ERL_NIF_TERM positive = enif_make_int(env, 1);
+            ERL_NIF_TERM negative = enif_make_int(env, -1);
+            ERL_NIF_TERM exponent = enif_make_int(env, -plan->scale);
+            current_term = fixed_size_binary_from_buffer(
+                env,
+                offset,
+                count,
+                bits / 8,
+                (const uint8_t *)values->buffers[bitmap_buffer_index],
+                (const uint8_t *)values->buffers[data_buffer_index],
+                [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
+                    uint64_t limbs[kDecimalMaxLimbs];
+                    bool is_negative = decimal_abs_limbs(val, nlimbs, limbs);
+                    ERL_NIF_TERM ex_decimal;
+                    ERL_NIF_TERM decimal_values[] = {
+                        kAtomDecimalModule,
+                        is_negative ? negative : positive,
+                        kAtomNil,
+                        exponent
+                    };
+                    if (!decimal_make_coefficient(env, limbs, nlimbs, decimal_values[2])) {
+                        coefficient_failed = true;
                     }
-                    current_term = fixed_size_binary_from_buffer(
-                        env,
-                        offset,
-                        count,
-                        bits / 8,
-                        (const uint8_t *)values->buffers[bitmap_buffer_index],
-                        (const uint8_t *)values->buffers[data_buffer_index],
-                        [&](ErlNifEnv *env, const uint8_t * val) -> ERL_NIF_TERM {
-                            return erlang::nif::make_binary(env, (const char *)val, bits / 8);
-                        }
-                    );
+                    enif_make_map_from_arrays(env, keys, decimal_values, 4, &ex_decimal);
+                    return ex_decimal;
                 }
-            } else {
-                format_processed = false;
+            );
+            if (coefficient_failed) {
+                error = erlang::nif::error(env, "cannot make the coefficient of a decimal value");
+                return 1;
             }
+            break;
         }
-    } else {
-        format_processed = false;
+        default:
+            format_processed = false;
+            break;
     }
 
     if (!format_processed) {
@@ -1725,8 +2315,8 @@ int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct
     return 0;
 }
 
-int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &out_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check) {
-    return arrow_array_to_nif_term(env, schema, values, 0, -1, level, out_terms, out_type, metadata, error, skip_dictionary_check);
+int arrow_array_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * values, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &out_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error, bool skip_dictionary_check, const ArrowDecoderPlan * plan, const ArrowDecodeOptions * options) {
+    return arrow_array_to_nif_term(env, schema, values, 0, -1, level, out_terms, out_type, metadata, error, skip_dictionary_check, plan, options);
 }
 
 #endif  // ADBC_ARROW_ARRAY_HPP
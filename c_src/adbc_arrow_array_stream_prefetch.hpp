@@ -0,0 +1,231 @@
+#ifndef ADBC_ARROW_ARRAY_STREAM_PREFETCH_HPP
+#define ADBC_ARROW_ARRAY_STREAM_PREFETCH_HPP
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <arrow-adbc/adbc.h>
+#include <erl_nif.h>
+#include <nanoarrow/nanoarrow.h>
+#include "adbc_thread_pool.hpp"
+
+/// A native reader thread that calls `get_next` on a stream ahead of the
+/// consumer and keeps up to `depth` batches in a ring buffer, so that the
+/// driver's I/O overlaps with the decoding of the previous batches.
+///
+/// The stream is moved into the prefetcher when the reader starts, so the
+/// reader thread is the only one calling its callbacks and the stream
+/// outlives the resource it came from if the prefetcher is detached.
+struct ArrowArrayStreamPrefetcher {
+    struct Item {
+        int code = 0;
+        struct ArrowArray array{};
+        // copy of `get_last_error`, only set if `code != 0`
+        std::string error;
+    };
+
+    struct ArrowArrayStream stream{};
+    ErlNifMutex * mutex = nullptr;
+    ErlNifCond * cond = nullptr;
+    ErlNifTid tid;
+    bool started = false;
+
+    // ring buffer shared by the reader thread (producer) and
+    // the stream's owner (consumer), guarded by `mutex`
+    std::vector<Item> items;
+    size_t head = 0;
+    size_t count = 0;
+    // set by the reader after it pushed the end of the stream or an error
+    bool done = false;
+    // set by the owner to make the reader exit
+    bool stopping = false;
+    // set by the reader right before its thread returns
+    bool exited = false;
+    // set by `detach`, the reader hands its own cleanup to this pool on exit
+    AdbcThreadPool * reaper = nullptr;
+    // a resource kept by `detach` for the driver object that produced the
+    // stream, released only after the stream itself
+    void * owner = nullptr;
+
+    /// Moves `stream` into the prefetcher and starts the reader thread.
+    /// `stream` is left as it was if failed.
+    /// @return 0 if success, 1 if failed
+    int start(struct ArrowArrayStream * stream, size_t depth) {
+        this->items.resize(depth > 0 ? depth : 1);
+        this->mutex = enif_mutex_create((char *)"adbc_stream_prefetch_mutex");
+        this->cond = enif_cond_create((char *)"adbc_stream_prefetch_cond");
+        if (this->mutex == nullptr || this->cond == nullptr) {
+            this->stop();
+            return 1;
+        }
+        ArrowArrayStreamMove(stream, &this->stream);
+        if (enif_thread_create((char *)"adbc_stream_prefetch", &this->tid, ArrowArrayStreamPrefetcher::run, this, nullptr) != 0) {
+            ArrowArrayStreamMove(&this->stream, stream);
+            this->stop();
+            return 1;
+        }
+        this->started = true;
+        return 0;
+    }
+
+    /// Pops the next batch, waiting for the reader if none is ready.
+    /// Returns the same as `get_next`, with `error` set if failed.
+    int next(struct ArrowArray * out, std::string &error) {
+        enif_mutex_lock(this->mutex);
+        while (this->count == 0 && !this->done) {
+            enif_cond_wait(this->cond, this->mutex);
+        }
+
+        int code = 0;
+        if (this->count == 0) {
+            // the end of the stream (or its error) was already consumed
+            memset(out, 0, sizeof(struct ArrowArray));
+        } else {
+            Item &item = this->items[this->head];
+            code = item.code;
+            if (code != 0) {
+                error = item.error;
+                // keep reporting the error to later calls
+                enif_mutex_unlock(this->mutex);
+                return code;
+            }
+            ArrowArrayMove(&item.array, out);
+            this->head = (this->head + 1) % this->items.size();
+            this->count--;
+            enif_cond_broadcast(this->cond);
+        }
+        enif_mutex_unlock(this->mutex);
+        return code;
+    }
+
+    /// Makes the reader thread exit without waiting for it, for callers that
+    /// must not block while the reader is stuck in `get_next`. The prefetcher
+    /// is deleted once the reader has exited, by `reaper` if it is still
+    /// running, or right away otherwise. It must not be used afterwards.
+    ///
+    /// If the reader is still running, `owner` (a resource such as the
+    /// statement the stream came from, or nullptr) is kept until the
+    /// stream is released, so the driver object is not released under it.
+    /// @return true if the reader was still running
+    static bool detach(ArrowArrayStreamPrefetcher * self, AdbcThreadPool * reaper, void * owner = nullptr) {
+        bool exited = true;
+        if (self->started) {
+            enif_mutex_lock(self->mutex);
+            self->stopping = true;
+            exited = self->exited || reaper == nullptr;
+            if (!exited) {
+                self->reaper = reaper;
+                if (owner != nullptr) {
+                    enif_keep_resource(owner);
+                    self->owner = owner;
+                }
+            }
+            enif_cond_broadcast(self->cond);
+            enif_mutex_unlock(self->mutex);
+        }
+
+        // the join in `stop` does not wait for a reader that already exited
+        if (exited) {
+            self->stop();
+            delete self;
+        }
+        return !exited;
+    }
+
+    /// Makes the reader thread exit, waits for it and releases the batches
+    /// it has read ahead and the stream.
+    void stop() {
+        if (this->started) {
+            enif_mutex_lock(this->mutex);
+            this->stopping = true;
+            enif_cond_broadcast(this->cond);
+            enif_mutex_unlock(this->mutex);
+            enif_thread_join(this->tid, nullptr);
+            this->started = false;
+        }
+
+        for (auto &item : this->items) {
+            if (item.array.release) {
+                item.array.release(&item.array);
+            }
+        }
+        this->items.clear();
+        this->count = 0;
+        if (this->stream.release) {
+            this->stream.release(&this->stream);
+        }
+        if (this->owner != nullptr) {
+            enif_release_resource(this->owner);
+            this->owner = nullptr;
+        }
+
+        if (this->cond) {
+            enif_cond_destroy(this->cond);
+            this->cond = nullptr;
+        }
+        if (this->mutex) {
+            enif_mutex_destroy(this->mutex);
+            this->mutex = nullptr;
+        }
+    }
+
+    // Called by the reader with `mutex` held, right before it returns.
+    // Once the mutex is released, the prefetcher may be deleted at any time.
+    static void * exit_reader(ArrowArrayStreamPrefetcher * self) {
+        self->exited = true;
+        AdbcThreadPool * reaper = self->reaper;
+        enif_mutex_unlock(self->mutex);
+        if (reaper != nullptr) {
+            reaper->submit([self]() {
+                self->stop();
+                delete self;
+            });
+        }
+        return nullptr;
+    }
+
+    static void * run(void * arg) {
+        auto self = (ArrowArrayStreamPrefetcher *)arg;
+        while (true) {
+            enif_mutex_lock(self->mutex);
+            while (self->count == self->items.size() && !self->stopping) {
+                enif_cond_wait(self->cond, self->mutex);
+            }
+            if (self->stopping) {
+                return exit_reader(self);
+            }
+            enif_mutex_unlock(self->mutex);
+
+            // only the reader touches the stream, `get_next` runs unlocked
+            Item item;
+            item.code = self->stream.get_next(&self->stream, &item.array);
+            if (item.code != 0) {
+                const char * reason = self->stream.get_last_error(&self->stream);
+                item.error = reason ? reason : "unknown error: cannot get next record with record->val.values";
+            }
+            bool last = item.code != 0 || item.array.release == nullptr;
+
+            enif_mutex_lock(self->mutex);
+            if (!last) {
+                Item &slot = self->items[(self->head + self->count) % self->items.size()];
+                slot.code = 0;
+                ArrowArrayMove(&item.array, &slot.array);
+                self->count++;
+            } else if (item.code != 0) {
+                Item &slot = self->items[(self->head + self->count) % self->items.size()];
+                slot.code = item.code;
+                slot.error = std::move(item.error);
+                self->count++;
+            }
+            self->done = last;
+            enif_cond_broadcast(self->cond);
+            if (last) {
+                return exit_reader(self);
+            }
+            enif_mutex_unlock(self->mutex);
+        }
+    }
+};
+
+#endif  // ADBC_ARROW_ARRAY_STREAM_PREFETCH_HPP
@@ -0,0 +1,288 @@
+#ifndef ADBC_ARROW_ARRAY_STREAM_QUEUE_HPP
+#define ADBC_ARROW_ARRAY_STREAM_QUEUE_HPP
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <erl_nif.h>
+#include <nanoarrow/nanoarrow.h>
+#include "adbc_consts.h"
+
+/// A bounded queue of record batches exposed as an `ArrowArrayStream`.
+///
+/// Producers (Elixir processes) push batches and finish the queue, while
+/// the consumer (the driver, usually on an executor thread) blocks in
+/// `get_schema` and `get_next` until a batch or the end of the stream
+/// arrives. At most `capacity` batches are kept in memory: pushing to a
+/// full queue fails without blocking the scheduler, and the producer is
+/// sent `{ref, :ready}` once the consumer makes room or goes away.
+///
+/// The queue is shared by the producer resource and the exported stream,
+/// and is deleted once both released it.
+struct ArrowArrayStreamQueue {
+    std::atomic<int> refs{1};
+    ErlNifMutex * mutex = nullptr;
+    ErlNifCond * cond = nullptr;
+    size_t capacity = 1;
+
+    // guarded by `mutex`
+    struct ArrowSchema schema{};
+    std::deque<struct ArrowArray> items;
+    // set by the producer once no more batches will be pushed
+    bool finished = false;
+    // set once the consumer released its stream
+    bool released = false;
+    // error given to the consumer after the last batch, if `code != 0`
+    int code = 0;
+    std::string error;
+    // the producer waiting for room, if `waiter_env` is set
+    ErlNifPid waiter_pid;
+    ErlNifEnv * waiter_env = nullptr;
+    ERL_NIF_TERM waiter_ref = 0;
+
+    /// @return a new queue, or `nullptr` if failed
+    static ArrowArrayStreamQueue * create(size_t capacity) {
+        auto queue = new ArrowArrayStreamQueue();
+        queue->capacity = capacity > 0 ? capacity : 1;
+        queue->mutex = enif_mutex_create((char *)"adbc_stream_queue_mutex");
+        queue->cond = enif_cond_create((char *)"adbc_stream_queue_cond");
+        if (queue->mutex == nullptr || queue->cond == nullptr) {
+            queue->release();
+            return nullptr;
+        }
+        return queue;
+    }
+
+    void retain() {
+        this->refs.fetch_add(1);
+    }
+
+    void release() {
+        if (this->refs.fetch_sub(1) == 1) {
+            delete this;
+        }
+    }
+
+    ~ArrowArrayStreamQueue() {
+        for (auto &item : this->items) {
+            if (item.release) item.release(&item);
+        }
+        if (this->schema.release) this->schema.release(&this->schema);
+        if (this->waiter_env) enif_free_env(this->waiter_env);
+        if (this->cond) enif_cond_destroy(this->cond);
+        if (this->mutex) enif_mutex_destroy(this->mutex);
+    }
+
+    /// Checks if a batch can be pushed right away. If the queue is full,
+    /// `{ref, :ready}` is sent to the process of `env` once the consumer
+    /// pops a batch or releases the stream.
+    /// @return false if the queue is full
+    bool has_room(ErlNifEnv * env, ERL_NIF_TERM ref) {
+        enif_mutex_lock(this->mutex);
+        bool room = this->items.size() < this->capacity || this->released || this->finished;
+        if (!room) {
+            if (this->waiter_env == nullptr) {
+                this->waiter_env = enif_alloc_env();
+            }
+            enif_self(env, &this->waiter_pid);
+            this->waiter_ref = enif_make_copy(this->waiter_env, ref);
+        }
+        enif_mutex_unlock(this->mutex);
+        return room;
+    }
+
+    /// Moves `array` into the queue. The schema of the first batch becomes
+    /// the schema of the stream, and the ones of the next batches must have
+    /// the same types, names and flags, otherwise the stream fails with
+    /// `EINVAL`.
+    /// @return 0 if pushed, 1 if the consumer is gone (the batch is dropped),
+    /// 2 if failed with `error` set, or 3 if the queue is full, in which case
+    /// `array` and `schema` are left untouched
+    int push(struct ArrowArray * array, struct ArrowSchema * schema, std::string &error) {
+        enif_mutex_lock(this->mutex);
+        int ret = 0;
+        if (this->released) {
+            ret = 1;
+        } else if (this->finished) {
+            error = "cannot push batches to a finished stream";
+            ret = 2;
+        } else if (this->items.size() >= this->capacity) {
+            ret = 3;
+        } else if (this->schema.release != nullptr && !ArrowArrayStreamQueue::same_schema(&this->schema, schema, "", error)) {
+            error = "expected all batches of the stream to have the same schema, " + error;
+            // the consumer cannot read batches of another type either
+            this->finished = true;
+            this->code = EINVAL;
+            this->error = error;
+            enif_cond_broadcast(this->cond);
+            ret = 2;
+        } else {
+            if (this->schema.release == nullptr) {
+                ArrowSchemaMove(schema, &this->schema);
+            }
+            struct ArrowArray item;
+            ArrowArrayMove(array, &item);
+            this->items.push_back(item);
+            enif_cond_broadcast(this->cond);
+        }
+        enif_mutex_unlock(this->mutex);
+
+        if (ret != 3) {
+            if (array->release) array->release(array);
+            if (schema->release) schema->release(schema);
+        }
+        return ret;
+    }
+
+    /// Marks the end of the stream, with an error if `code != 0`.
+    /// Does nothing if the queue was already finished.
+    void finish(int code, const std::string &error) {
+        enif_mutex_lock(this->mutex);
+        if (!this->finished) {
+            this->finished = true;
+            this->code = code;
+            this->error = error;
+            enif_cond_broadcast(this->cond);
+        }
+        enif_mutex_unlock(this->mutex);
+    }
+
+    /// Exports the queue as a stream, which holds a reference to it
+    void export_to(struct ArrowArrayStream * out) {
+        this->retain();
+        out->get_schema = ArrowArrayStreamQueue::get_schema;
+        out->get_next = ArrowArrayStreamQueue::get_next;
+        out->get_last_error = ArrowArrayStreamQueue::get_last_error;
+        out->release = ArrowArrayStreamQueue::release_stream;
+        out->private_data = this;
+    }
+
+    static int get_schema(struct ArrowArrayStream * stream, struct ArrowSchema * out) {
+        auto self = (ArrowArrayStreamQueue *)stream->private_data;
+        enif_mutex_lock(self->mutex);
+        while (self->schema.release == nullptr && !self->finished) {
+            enif_cond_wait(self->cond, self->mutex);
+        }
+
+        int code = 0;
+        if (self->schema.release != nullptr) {
+            code = ArrowSchemaDeepCopy(&self->schema, out);
+        } else if (self->code != 0) {
+            code = self->code;
+        } else {
+            self->error = "cannot get the schema of a stream finished without batches";
+            code = EINVAL;
+        }
+        enif_mutex_unlock(self->mutex);
+        return code;
+    }
+
+    static int get_next(struct ArrowArrayStream * stream, struct ArrowArray * out) {
+        auto self = (ArrowArrayStreamQueue *)stream->private_data;
+        enif_mutex_lock(self->mutex);
+        while (self->items.empty() && !self->finished) {
+            enif_cond_wait(self->cond, self->mutex);
+        }
+
+        int code = 0;
+        if (!self->items.empty()) {
+            ArrowArrayMove(&self->items.front(), out);
+            self->items.pop_front();
+            self->notify_waiter();
+        } else if (self->code != 0) {
+            code = self->code;
+        } else {
+            out->release = nullptr;
+        }
+        enif_mutex_unlock(self->mutex);
+        return code;
+    }
+
+private:
+    /// Sends `{ref, :ready}` to the producer waiting for room, if any.
+    /// Must be called with `mutex` held.
+    void notify_waiter() {
+        if (this->waiter_env == nullptr) return;
+        ERL_NIF_TERM msg = enif_make_tuple2(this->waiter_env, this->waiter_ref, kAtomReady);
+        enif_send(nullptr, &this->waiter_pid, this->waiter_env, msg);
+        enif_free_env(this->waiter_env);
+        this->waiter_env = nullptr;
+    }
+
+    static bool same_string(const char * a, const char * b) {
+        if (a == nullptr || b == nullptr) return a == b;
+        return strcmp(a, b) == 0;
+    }
+
+    /// Compares the format, name and flags of `actual` and its children
+    /// with `expected`
+    /// @return false with `error` set if they differ
+    static bool same_schema(const struct ArrowSchema * expected, const struct ArrowSchema * actual, const std::string &path, std::string &error) {
+        std::string field = path.empty() ? "the batch" : "field `" + path + "`";
+        if (!same_string(expected->format, actual->format)) {
+            error = field + " has format `" + (actual->format ? actual->format : "") + "`, expected: `" + (expected->format ? expected->format : "") + "`";
+            return false;
+        }
+        if (!path.empty() && !same_string(expected->name, actual->name)) {
+            error = field + " is named `" + (actual->name ? actual->name : "") + "`, expected: `" + (expected->name ? expected->name : "") + "`";
+            return false;
+        }
+        if (expected->flags != actual->flags) {
+            error = field + " has flags " + std::to_string(actual->flags) + ", expected: " + std::to_string(expected->flags);
+            return false;
+        }
+        if (expected->n_children != actual->n_children) {
+            error = field + " has " + std::to_string(actual->n_children) + " children, expected: " + std::to_string(expected->n_children);
+            return false;
+        }
+        if ((expected->dictionary == nullptr) != (actual->dictionary == nullptr)) {
+            error = field + (actual->dictionary ? " is" : " is not") + " dictionary encoded";
+            return false;
+        }
+        if (expected->dictionary != nullptr && !same_schema(expected->dictionary, actual->dictionary, path + "(dictionary)", error)) {
+            return false;
+        }
+        for (int64_t i = 0; i < expected->n_children; i++) {
+            const char * name = expected->children[i]->name;
+            std::string child_path = (path.empty() ? "" : path + ".") + (name && *name ? name : std::to_string(i));
+            if (!same_schema(expected->children[i], actual->children[i], child_path, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    static const char * get_last_error(struct ArrowArrayStream * stream) {
+        auto self = (ArrowArrayStreamQueue *)stream->private_data;
+        enif_mutex_lock(self->mutex);
+        const char * error = self->error.empty() ? nullptr : self->error.c_str();
+        enif_mutex_unlock(self->mutex);
+        return error;
+    }
+
+    static void release_stream(struct ArrowArrayStream * stream) {
+        auto self = (ArrowArrayStreamQueue *)stream->private_data;
+        // wake up the producer waiting for room, its next push is dropped
+        enif_mutex_lock(self->mutex);
+        self->released = true;
+        self->notify_waiter();
+        enif_mutex_unlock(self->mutex);
+
+        self->release();
+        stream->release = nullptr;
+        stream->private_data = nullptr;
+    }
+};
+
+/// The producer side of an `ArrowArrayStreamQueue`, owned by Elixir.
+/// If it is garbage collected before finishing the queue, the consumer
+/// gets an error instead of waiting forever.
+struct ArrowArrayStreamQueueProducer {
+    ArrowArrayStreamQueue * queue;
+};
+
+#endif  // ADBC_ARROW_ARRAY_STREAM_QUEUE_HPP
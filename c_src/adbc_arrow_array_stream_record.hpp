@@ -3,11 +3,38 @@
 #pragma once
 
 #include <arrow-adbc/adbc.h>
+#include "adbc_arrow_array_stream_prefetch.hpp"
+#include "adbc_arrow_decoder_plan.hpp"
+
+/// Per-stream data kept in `NifRes<ArrowArrayStream>::private_data`,
+/// allocated once when the first batch is fetched.
+struct ArrowArrayStreamPrivateData {
+    // the stream's schema and the decoder plan compiled from it,
+    // shared with every record of the stream
+    SharedArrowDecoderPlan * plan;
+
+    // `%Adbc.Column{}` of every column with `data: nil`, built once from
+    // the schema in `columns_env` and reused for every batch
+    ErlNifEnv * columns_env;
+    ERL_NIF_TERM columns;
+
+    // reads batches ahead of the consumer, nullptr unless enabled
+    // with `adbc_arrow_array_stream_prefetch`
+    ArrowArrayStreamPrefetcher * prefetcher;
+};
 
 struct ArrowArrayStreamRecord {
     struct ArrowSchema *schema = nullptr;
     struct ArrowArray *values = nullptr;
 
+    // the decoder plan for `schema`, a node owned by `plan_owner`
+    SharedArrowDecoderPlan *plan_owner = nullptr;
+    const ArrowDecoderPlan *plan = nullptr;
+
+    // whether `schema` is a copy owned by the record or borrowed
+    // from the schema kept by `plan_owner`
+    bool owns_schema = false;
+
     /// Allocate memory for schema and values
     /// @return 0 if success, 1 if failed
     int allocate_schema_and_values() {
@@ -24,18 +51,53 @@ struct ArrowArrayStreamRecord {
             return 1;
         }
         memset(this->values, 0, sizeof(struct ArrowArray));
-        
+        this->owns_schema = true;
+
         return 0;
     }
 
+    /// Allocate memory for values, and borrow the schema of column `index`
+    /// of a stream from the stream's plan
+    /// @return 0 if success, 1 if failed
+    int allocate_values_with_stream_schema(SharedArrowDecoderPlan * owner, int64_t index) {
+        this->values = (struct ArrowArray *)enif_alloc(sizeof(struct ArrowArray));
+        if (this->values == nullptr) {
+            return 1;
+        }
+        memset(this->values, 0, sizeof(struct ArrowArray));
+
+        this->set_plan(owner, &owner->root.children[index]);
+        this->schema = owner->schema.children[index];
+        this->owns_schema = false;
+        return 0;
+    }
+
+    /// Share a node of a stream's decoder plan with this record
+    void set_plan(SharedArrowDecoderPlan * owner, const ArrowDecoderPlan * node) {
+        keep_shared_arrow_decoder_plan(owner);
+        release_shared_arrow_decoder_plan(this->plan_owner);
+        this->plan_owner = owner;
+        this->plan = node;
+    }
+
+    void release_plan() {
+        release_shared_arrow_decoder_plan(this->plan_owner);
+        this->plan_owner = nullptr;
+        this->plan = nullptr;
+    }
+
     void release_schema_and_values() {
-        if (this->schema) {
+        if (this->schema && this->owns_schema) {
             if (this->schema->release) {
                 this->schema->release(this->schema);
             }
             enif_free(this->schema);
-            this->schema = nullptr;
         }
+        this->schema = nullptr;
+        if (this->plan_owner && this->values) {
+            this->plan_owner->dictionaries.evict(this->values->dictionary);
+        }
+        this->release_plan();
 
         if (this->values) {
             if (this->values->release) {
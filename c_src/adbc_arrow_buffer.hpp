@@ -0,0 +1,78 @@
+#ifndef ADBC_ARROW_BUFFER_HPP
+#define ADBC_ARROW_BUFFER_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "adbc_arrow_decoder_plan.hpp"
+
+/// Number of bytes of one value in the data buffer of a fixed width type,
+/// or 0 if values of this type are not stored as fixed width values
+/// (variable size, nested and bit-packed types).
+static int64_t arrow_fixed_width_bytes(const ArrowDecoderPlan &plan) {
+    switch (plan.kind) {
+        case ArrowDecoderKind::Int8:
+        case ArrowDecoderKind::UInt8:
+            return 1;
+        case ArrowDecoderKind::Int16:
+        case ArrowDecoderKind::UInt16:
+        case ArrowDecoderKind::HalfFloat:
+            return 2;
+        case ArrowDecoderKind::Int32:
+        case ArrowDecoderKind::UInt32:
+        case ArrowDecoderKind::Float:
+        case ArrowDecoderKind::Date32:
+        case ArrowDecoderKind::IntervalMonth:
+            return 4;
+        case ArrowDecoderKind::Int64:
+        case ArrowDecoderKind::UInt64:
+        case ArrowDecoderKind::Double:
+        case ArrowDecoderKind::Date64:
+        case ArrowDecoderKind::Duration:
+        case ArrowDecoderKind::Timestamp:
+        case ArrowDecoderKind::IntervalDayTime:
+            return 8;
+        case ArrowDecoderKind::Time:
+            // time32 for seconds and milliseconds, time64 otherwise
+            return (plan.unit == 's' || plan.unit == 'm') ? 4 : 8;
+        case ArrowDecoderKind::IntervalMonthDayNano:
+            return 16;
+        case ArrowDecoderKind::Decimal:
+            return plan.bits / 8;
+        case ArrowDecoderKind::FixedSizeBinary:
+            return plan.fixed_size;
+        default:
+            return 0;
+    }
+}
+
+/// Copy `length` bits of a validity bitmap starting at bit `src_offset` of `src`
+/// to bit `dst_offset` of `dst`. A `nullptr` `src` means all values are valid.
+///
+/// The bits being written in `dst` must be zeroed beforehand.
+static void copy_arrow_validity_bitmap(uint8_t * dst, int64_t dst_offset, const uint8_t * src, int64_t src_offset, int64_t length) {
+    if (src == nullptr) {
+        for (int64_t i = dst_offset; i < dst_offset + length; i++) {
+            dst[i / 8] |= (uint8_t)(1 << (i % 8));
+        }
+        return;
+    }
+
+    if (dst_offset % 8 == 0 && src_offset % 8 == 0) {
+        int64_t whole_bytes = length / 8;
+        memcpy(dst + dst_offset / 8, src + src_offset / 8, (size_t)whole_bytes);
+        dst_offset += whole_bytes * 8;
+        src_offset += whole_bytes * 8;
+        length -= whole_bytes * 8;
+    }
+
+    for (int64_t i = 0; i < length; i++) {
+        int64_t src_bit = src_offset + i;
+        if (src[src_bit / 8] & (1 << (src_bit % 8))) {
+            int64_t dst_bit = dst_offset + i;
+            dst[dst_bit / 8] |= (uint8_t)(1 << (dst_bit % 8));
+        }
+    }
+}
+
+#endif  // ADBC_ARROW_BUFFER_HPP
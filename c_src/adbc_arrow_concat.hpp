@@ -0,0 +1,338 @@
+#ifndef ADBC_ARROW_CONCAT_HPP
+#define ADBC_ARROW_CONCAT_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <nanoarrow/nanoarrow.h>
+#include "adbc_arrow_buffer.hpp"
+#include "adbc_arrow_decoder_plan.hpp"
+
+/// `length` values of `array` starting at the physical index `offset`,
+/// that is, `offset` already includes `array->offset`.
+struct ArrowArraySlice {
+    const struct ArrowArray * array;
+    int64_t offset;
+    int64_t length;
+};
+
+/// Whether arrays of `schema` can be concatenated by `concat_arrow_array_slices`
+static bool is_arrow_array_concatenable(const struct ArrowSchema * schema, const ArrowDecoderPlan &plan) {
+    if (schema == nullptr || schema->dictionary != nullptr) {
+        return false;
+    }
+
+    switch (plan.kind) {
+        case ArrowDecoderKind::Unsupported:
+        case ArrowDecoderKind::ListView:
+        case ArrowDecoderKind::LargeListView:
+        case ArrowDecoderKind::DenseUnion:
+        case ArrowDecoderKind::SparseUnion:
+        case ArrowDecoderKind::RunEndEncoded:
+            return false;
+        default:
+            break;
+    }
+
+    if ((int64_t)plan.children.size() != schema->n_children) {
+        return false;
+    }
+    for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+        if (!is_arrow_array_concatenable(schema->children[child_i], plan.children[child_i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int64_t arrow_array_slice_null_count(const ArrowArraySlice &slice) {
+    const uint8_t * validity = (const uint8_t *)slice.array->buffers[0];
+    if (validity == nullptr || slice.length == 0) {
+        return 0;
+    }
+    if (slice.array->null_count >= 0 && slice.offset == slice.array->offset && slice.length == slice.array->length) {
+        return slice.array->null_count;
+    }
+    return slice.length - ArrowBitCountSet(validity, slice.offset, slice.offset + slice.length);
+}
+
+/// Copies the validity bitmaps of `slices` into `out`, only allocating one if
+/// any of the slices has nulls
+static int concat_arrow_validity(const std::vector<ArrowArraySlice> &slices, int64_t total_length, struct ArrowArray * out) {
+    int64_t null_count = 0;
+    for (auto &slice : slices) {
+        null_count += arrow_array_slice_null_count(slice);
+    }
+    out->null_count = null_count;
+    if (null_count == 0) {
+        return 0;
+    }
+
+    struct ArrowBitmap * bitmap = ArrowArrayValidityBitmap(out);
+    if (ArrowBitmapReserve(bitmap, total_length) != NANOARROW_OK) {
+        return 1;
+    }
+    memset(bitmap->buffer.data, 0, (size_t)((total_length + 7) / 8));
+
+    int64_t bit_offset = 0;
+    for (auto &slice : slices) {
+        copy_arrow_validity_bitmap(bitmap->buffer.data, bit_offset, (const uint8_t *)slice.array->buffers[0], slice.offset, slice.length);
+        bit_offset += slice.length;
+    }
+    bitmap->buffer.size_bytes = (total_length + 7) / 8;
+    bitmap->size_bits = total_length;
+    return 0;
+}
+
+/// Concatenates the offsets and data buffers of variable size binaries
+template <typename OffsetType>
+static int concat_arrow_binary(const std::vector<ArrowArraySlice> &slices, int64_t total_length, struct ArrowArray * out) {
+    struct ArrowBuffer * offsets = ArrowArrayBuffer(out, 1);
+    struct ArrowBuffer * data = ArrowArrayBuffer(out, 2);
+
+    int64_t data_bytes = 0;
+    for (auto &slice : slices) {
+        if (slice.length == 0) continue;
+        const OffsetType * src = (const OffsetType *)slice.array->buffers[1];
+        data_bytes += (int64_t)(src[slice.offset + slice.length] - src[slice.offset]);
+    }
+    if (data_bytes > (int64_t)std::numeric_limits<OffsetType>::max()) {
+        return 1;
+    }
+
+    if (ArrowBufferReserve(offsets, (total_length + 1) * (int64_t)sizeof(OffsetType)) != NANOARROW_OK ||
+        ArrowBufferReserve(data, data_bytes) != NANOARROW_OK) {
+        return 1;
+    }
+
+    OffsetType * dst_offsets = (OffsetType *)offsets->data;
+    OffsetType position = 0;
+    int64_t dst_i = 0;
+    dst_offsets[dst_i++] = 0;
+    for (auto &slice : slices) {
+        if (slice.length == 0) continue;
+        const OffsetType * src = (const OffsetType *)slice.array->buffers[1];
+        OffsetType start = src[slice.offset];
+        OffsetType end = src[slice.offset + slice.length];
+        for (int64_t i = 1; i <= slice.length; i++) {
+            dst_offsets[dst_i++] = position + (src[slice.offset + i] - start);
+        }
+        if (end > start) {
+            memcpy(data->data + position, (const uint8_t *)slice.array->buffers[2] + start, (size_t)(end - start));
+        }
+        position += end - start;
+    }
+    offsets->size_bytes = (total_length + 1) * (int64_t)sizeof(OffsetType);
+    data->size_bytes = data_bytes;
+    return 0;
+}
+
+static int concat_arrow_array_slices(const struct ArrowSchema * schema, const ArrowDecoderPlan &plan, const std::vector<ArrowArraySlice> &slices, struct ArrowArray * out);
+
+/// Concatenates the offsets of (large) lists and the ranges of the child
+/// array they point to
+template <typename OffsetType>
+static int concat_arrow_list(const struct ArrowSchema * schema, const ArrowDecoderPlan &plan, const std::vector<ArrowArraySlice> &slices, int64_t total_length, struct ArrowArray * out) {
+    struct ArrowBuffer * offsets = ArrowArrayBuffer(out, 1);
+    if (ArrowBufferReserve(offsets, (total_length + 1) * (int64_t)sizeof(OffsetType)) != NANOARROW_OK) {
+        return 1;
+    }
+
+    std::vector<ArrowArraySlice> child_slices;
+    child_slices.reserve(slices.size());
+    OffsetType * dst_offsets = (OffsetType *)offsets->data;
+    int64_t position = 0;
+    int64_t dst_i = 0;
+    dst_offsets[dst_i++] = 0;
+    for (auto &slice : slices) {
+        if (slice.length == 0) continue;
+        const OffsetType * src = (const OffsetType *)slice.array->buffers[1];
+        OffsetType start = src[slice.offset];
+        OffsetType end = src[slice.offset + slice.length];
+        if (position + (int64_t)(end - start) > (int64_t)std::numeric_limits<OffsetType>::max()) {
+            return 1;
+        }
+        for (int64_t i = 1; i <= slice.length; i++) {
+            dst_offsets[dst_i++] = (OffsetType)(position + (src[slice.offset + i] - start));
+        }
+        position += end - start;
+
+        const struct ArrowArray * child = slice.array->children[0];
+        child_slices.push_back({child, child->offset + (int64_t)start, (int64_t)(end - start)});
+    }
+    offsets->size_bytes = (total_length + 1) * (int64_t)sizeof(OffsetType);
+
+    return concat_arrow_array_slices(schema->children[0], plan.children[0], child_slices, out->children[0]);
+}
+
+/// Concatenates `slices` into `out`, an array initialised from `schema`
+/// with `ArrowArrayInitFromSchema`. `out` still has to be finished with
+/// `ArrowArrayFinishBuilding` once the whole tree has been filled.
+///
+/// Callers have to check `is_arrow_array_concatenable` first.
+/// @return 0 if success, 1 if failed
+static int concat_arrow_array_slices(const struct ArrowSchema * schema, const ArrowDecoderPlan &plan, const std::vector<ArrowArraySlice> &slices, struct ArrowArray * out) {
+    int64_t total_length = 0;
+    for (auto &slice : slices) {
+        total_length += slice.length;
+    }
+    out->length = total_length;
+
+    if (plan.kind == ArrowDecoderKind::Null) {
+        out->null_count = total_length;
+        return 0;
+    }
+
+    if (concat_arrow_validity(slices, total_length, out) != 0) {
+        return 1;
+    }
+
+    switch (plan.kind) {
+        case ArrowDecoderKind::Bool: {
+            struct ArrowBuffer * data = ArrowArrayBuffer(out, 1);
+            if (ArrowBufferReserve(data, (total_length + 7) / 8) != NANOARROW_OK) {
+                return 1;
+            }
+            memset(data->data, 0, (size_t)((total_length + 7) / 8));
+            int64_t bit_offset = 0;
+            for (auto &slice : slices) {
+                if (slice.length == 0) continue;
+                copy_arrow_validity_bitmap(data->data, bit_offset, (const uint8_t *)slice.array->buffers[1], slice.offset, slice.length);
+                bit_offset += slice.length;
+            }
+            data->size_bytes = (total_length + 7) / 8;
+            return 0;
+        }
+        case ArrowDecoderKind::String:
+        case ArrowDecoderKind::Binary:
+            return concat_arrow_binary<int32_t>(slices, total_length, out);
+        case ArrowDecoderKind::LargeString:
+        case ArrowDecoderKind::LargeBinary:
+            return concat_arrow_binary<int64_t>(slices, total_length, out);
+        case ArrowDecoderKind::List:
+        case ArrowDecoderKind::Map:
+            return concat_arrow_list<int32_t>(schema, plan, slices, total_length, out);
+        case ArrowDecoderKind::LargeList:
+            return concat_arrow_list<int64_t>(schema, plan, slices, total_length, out);
+        case ArrowDecoderKind::FixedSizeList: {
+            std::vector<ArrowArraySlice> child_slices;
+            child_slices.reserve(slices.size());
+            for (auto &slice : slices) {
+                const struct ArrowArray * child = slice.array->children[0];
+                child_slices.push_back({child, child->offset + slice.offset * plan.fixed_size, slice.length * plan.fixed_size});
+            }
+            return concat_arrow_array_slices(schema->children[0], plan.children[0], child_slices, out->children[0]);
+        }
+        case ArrowDecoderKind::Struct: {
+            std::vector<ArrowArraySlice> child_slices(slices.size());
+            for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+                for (size_t slice_i = 0; slice_i < slices.size(); slice_i++) {
+                    const ArrowArraySlice &slice = slices[slice_i];
+                    const struct ArrowArray * child = slice.array->children[child_i];
+                    child_slices[slice_i] = {child, child->offset + slice.offset, slice.length};
+                }
+                if (concat_arrow_array_slices(schema->children[child_i], plan.children[child_i], child_slices, out->children[child_i]) != 0) {
+                    return 1;
+                }
+            }
+            return 0;
+        }
+        default:
+            break;
+    }
+
+    int64_t value_bytes = arrow_fixed_width_bytes(plan);
+    if (value_bytes <= 0) {
+        return 1;
+    }
+    struct ArrowBuffer * data = ArrowArrayBuffer(out, 1);
+    if (ArrowBufferReserve(data, total_length * value_bytes) != NANOARROW_OK) {
+        return 1;
+    }
+    for (auto &slice : slices) {
+        if (slice.length == 0) continue;
+        memcpy(data->data + data->size_bytes, (const uint8_t *)slice.array->buffers[1] + slice.offset * value_bytes, (size_t)(slice.length * value_bytes));
+        data->size_bytes += slice.length * value_bytes;
+    }
+    return 0;
+}
+
+/// Concatenates the batches in `arrays` of a column into a single array
+/// with contiguous buffers.
+/// @return 0 if success, 1 if failed, in which case `out` is left released
+static int concat_arrow_arrays(const struct ArrowSchema * schema, const ArrowDecoderPlan &plan, const std::vector<const struct ArrowArray *> &arrays, struct ArrowArray * out) {
+    std::vector<ArrowArraySlice> slices;
+    slices.reserve(arrays.size());
+    for (auto array : arrays) {
+        slices.push_back({array, array->offset, array->length});
+    }
+
+    struct ArrowError error{};
+    if (ArrowArrayInitFromSchema(out, schema, &error) != NANOARROW_OK) {
+        return 1;
+    }
+    if (concat_arrow_array_slices(schema, plan, slices, out) != 0 ||
+        ArrowArrayFinishBuilding(out, NANOARROW_VALIDATION_LEVEL_MINIMAL, &error) != NANOARROW_OK) {
+        out->release(out);
+        return 1;
+    }
+    return 0;
+}
+
+/// Approximate number of bytes referenced by `slice`, used to apply
+/// memory budgets. Types that cannot be concatenated count as 0.
+static int64_t arrow_array_slice_bytes(const ArrowDecoderPlan &plan, const ArrowArraySlice &slice) {
+    if (slice.length == 0) {
+        return 0;
+    }
+
+    int64_t bytes = slice.array->buffers != nullptr && slice.array->n_buffers > 0 && slice.array->buffers[0] != nullptr ? (slice.length + 7) / 8 : 0;
+    switch (plan.kind) {
+        case ArrowDecoderKind::Bool:
+            return bytes + (slice.length + 7) / 8;
+        case ArrowDecoderKind::String:
+        case ArrowDecoderKind::Binary: {
+            const int32_t * offsets = (const int32_t *)slice.array->buffers[1];
+            return bytes + (slice.length + 1) * 4 + (offsets[slice.offset + slice.length] - offsets[slice.offset]);
+        }
+        case ArrowDecoderKind::LargeString:
+        case ArrowDecoderKind::LargeBinary: {
+            const int64_t * offsets = (const int64_t *)slice.array->buffers[1];
+            return bytes + (slice.length + 1) * 8 + (offsets[slice.offset + slice.length] - offsets[slice.offset]);
+        }
+        case ArrowDecoderKind::List:
+        case ArrowDecoderKind::Map: {
+            const int32_t * offsets = (const int32_t *)slice.array->buffers[1];
+            const struct ArrowArray * child = slice.array->children[0];
+            ArrowArraySlice child_slice{child, child->offset + offsets[slice.offset], offsets[slice.offset + slice.length] - offsets[slice.offset]};
+            return bytes + (slice.length + 1) * 4 + arrow_array_slice_bytes(plan.children[0], child_slice);
+        }
+        case ArrowDecoderKind::LargeList: {
+            const int64_t * offsets = (const int64_t *)slice.array->buffers[1];
+            const struct ArrowArray * child = slice.array->children[0];
+            ArrowArraySlice child_slice{child, child->offset + offsets[slice.offset], offsets[slice.offset + slice.length] - offsets[slice.offset]};
+            return bytes + (slice.length + 1) * 8 + arrow_array_slice_bytes(plan.children[0], child_slice);
+        }
+        case ArrowDecoderKind::FixedSizeList: {
+            const struct ArrowArray * child = slice.array->children[0];
+            ArrowArraySlice child_slice{child, child->offset + slice.offset * plan.fixed_size, slice.length * plan.fixed_size};
+            return bytes + arrow_array_slice_bytes(plan.children[0], child_slice);
+        }
+        case ArrowDecoderKind::Struct: {
+            for (size_t child_i = 0; child_i < plan.children.size() && (int64_t)child_i < slice.array->n_children; child_i++) {
+                const struct ArrowArray * child = slice.array->children[child_i];
+                ArrowArraySlice child_slice{child, child->offset + slice.offset, slice.length};
+                bytes += arrow_array_slice_bytes(plan.children[child_i], child_slice);
+            }
+            return bytes;
+        }
+        default: {
+            int64_t value_bytes = arrow_fixed_width_bytes(plan);
+            return value_bytes > 0 ? bytes + slice.length * value_bytes : 0;
+        }
+    }
+}
+
+#endif  // ADBC_ARROW_CONCAT_HPP
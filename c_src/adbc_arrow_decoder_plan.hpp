@@ -0,0 +1,304 @@
+#ifndef ADBC_ARROW_DECODER_PLAN_HPP
+#define ADBC_ARROW_DECODER_PLAN_HPP
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <arrow-adbc/adbc.h>
+#include "adbc_arrow_dictionary_cache.hpp"
+
+enum class ArrowDecoderKind : uint8_t {
+    Unsupported = 0,
+    Null,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    HalfFloat,
+    Float,
+    Double,
+    Bool,
+    String,
+    Binary,
+    LargeString,
+    LargeBinary,
+    FixedSizeBinary,
+    Decimal,
+    Date32,
+    Date64,
+    Time,
+    Duration,
+    IntervalMonth,
+    IntervalDayTime,
+    IntervalMonthDayNano,
+    Timestamp,
+    Struct,
+    Map,
+    List,
+    LargeList,
+    FixedSizeList,
+    ListView,
+    LargeListView,
+    DenseUnion,
+    SparseUnion,
+    RunEndEncoded,
+};
+
+/// A decoder plan is the parsed form of an ArrowSchema.
+///
+/// `ArrowSchema.format` is parsed exactly once per schema node when the plan
+/// is compiled, and the decoder in `adbc_arrow_array.hpp` then switches on
+/// `kind` instead of re-parsing the format string for every (nested) call.
+///
+/// The plan tree mirrors the schema tree: `children[i]` is the plan for
+/// `schema->children[i]` and `dictionary` is the plan for `schema->dictionary`.
+/// It does not keep any pointer into the schema it was compiled from, so the
+/// same plan can be used with a deep copy of that schema.
+struct ArrowDecoderPlan {
+    ArrowDecoderKind kind = ArrowDecoderKind::Unsupported;
+
+    // time unit for temporal types, one of 's', 'm', 'u', 'n'
+    // or 'D'/'m' for date32/date64
+    char unit = '\0';
+
+    // number of items for fixed size lists, number of bytes for fixed size binaries
+    int64_t fixed_size = 0;
+
+    // decimal parameters, `d:P,S[,N]`
+    int precision = 0;
+    int scale = 0;
+    int bits = 0;
+
+    // timezone for timestamps, `ts?:timezone`
+    bool has_timezone = false;
+    std::string timezone;
+
+    std::vector<ArrowDecoderPlan> children;
+    std::unique_ptr<ArrowDecoderPlan> dictionary;
+};
+
+/// A refcounted decoder plan, so that the plan compiled for a stream can be
+/// shared with every `ArrowArrayStreamRecord` created from that stream.
+///
+/// Plans created with `new_shared_arrow_stream_plan` also own the stream's
+/// schema, and records borrow their column's schema from it instead of
+/// keeping a deep copy.
+struct SharedArrowDecoderPlan {
+    std::atomic<int64_t> refcount{1};
+    ArrowDecoderPlan root;
+    struct ArrowSchema schema{};
+    // decoded dictionary values, shared by the batches of the stream
+    ArrowDictionaryCache dictionaries;
+
+    ~SharedArrowDecoderPlan() {
+        if (schema.release) {
+            schema.release(&schema);
+        }
+    }
+};
+
+static bool parse_arrow_decoder_plan_uint(const char * str, int64_t &out) {
+    if (*str == '\0') return false;
+    int64_t value = 0;
+    for (; *str != '\0'; str++) {
+        if (*str < '0' || *str > '9') return false;
+        value = value * 10 + (*str - '0');
+    }
+    out = value;
+    return true;
+}
+
+static void compile_arrow_decoder_plan_format(const char * format, ArrowDecoderPlan &plan) {
+    size_t format_len = strlen(format);
+    plan.kind = ArrowDecoderKind::Unsupported;
+
+    if (format_len == 1) {
+        switch (format[0]) {
+            case 'n': plan.kind = ArrowDecoderKind::Null; break;
+            case 'c': plan.kind = ArrowDecoderKind::Int8; break;
+            case 's': plan.kind = ArrowDecoderKind::Int16; break;
+            case 'i': plan.kind = ArrowDecoderKind::Int32; break;
+            case 'l': plan.kind = ArrowDecoderKind::Int64; break;
+            case 'C': plan.kind = ArrowDecoderKind::UInt8; break;
+            case 'S': plan.kind = ArrowDecoderKind::UInt16; break;
+            case 'I': plan.kind = ArrowDecoderKind::UInt32; break;
+            case 'L': plan.kind = ArrowDecoderKind::UInt64; break;
+            case 'e': plan.kind = ArrowDecoderKind::HalfFloat; break;
+            case 'f': plan.kind = ArrowDecoderKind::Float; break;
+            case 'g': plan.kind = ArrowDecoderKind::Double; break;
+            case 'b': plan.kind = ArrowDecoderKind::Bool; break;
+            case 'u': plan.kind = ArrowDecoderKind::String; break;
+            case 'z': plan.kind = ArrowDecoderKind::Binary; break;
+            case 'U': plan.kind = ArrowDecoderKind::LargeString; break;
+            case 'Z': plan.kind = ArrowDecoderKind::LargeBinary; break;
+            default: break;
+        }
+    } else if (format_len == 2) {
+        if (strncmp("+s", format, 2) == 0) {
+            plan.kind = ArrowDecoderKind::Struct;
+        } else if (strncmp("+r", format, 2) == 0) {
+            plan.kind = ArrowDecoderKind::RunEndEncoded;
+        } else if (strncmp("+m", format, 2) == 0) {
+            plan.kind = ArrowDecoderKind::Map;
+        } else if (strncmp("+l", format, 2) == 0) {
+            plan.kind = ArrowDecoderKind::List;
+        } else if (strncmp("+L", format, 2) == 0) {
+            plan.kind = ArrowDecoderKind::LargeList;
+        }
+    } else if (format[0] == 't') {
+        if (format_len == 3) {
+            char unit = format[2];
+            if (format[1] == 'd') {
+                // tdD - date32 [days]
+                // tdm - date64 [milliseconds]
+                if (unit == 'D') {
+                    plan.kind = ArrowDecoderKind::Date32;
+                } else if (unit == 'm') {
+                    plan.kind = ArrowDecoderKind::Date64;
+                }
+                plan.unit = unit;
+            } else if (format[1] == 't' || format[1] == 'D') {
+                // tts, ttm, ttu, ttn - time32/time64
+                // tDs, tDm, tDu, tDn - duration
+                if (unit == 's' || unit == 'm' || unit == 'u' || unit == 'n') {
+                    plan.kind = format[1] == 't' ? ArrowDecoderKind::Time : ArrowDecoderKind::Duration;
+                    plan.unit = unit;
+                }
+            } else if (format[1] == 'i') {
+                // tiM - interval [months]
+                // tiD - interval [days, time]
+                // tin - interval [month, day, nanoseconds]
+                if (unit == 'M') {
+                    plan.kind = ArrowDecoderKind::IntervalMonth;
+                } else if (unit == 'D') {
+                    plan.kind = ArrowDecoderKind::IntervalDayTime;
+                } else if (unit == 'n') {
+                    plan.kind = ArrowDecoderKind::IntervalMonthDayNano;
+                }
+            }
+        } else if (format_len >= 4 && format[1] == 's' && format[3] == ':') {
+            // tss:, tsm:, tsu:, tsn: with an optional timezone after the colon
+            char unit = format[2];
+            if (unit == 's' || unit == 'm' || unit == 'u' || unit == 'n') {
+                plan.kind = ArrowDecoderKind::Timestamp;
+                plan.unit = unit;
+                if (format_len > 4) {
+                    plan.has_timezone = true;
+                    plan.timezone = std::string(&format[4]);
+                }
+            }
+        }
+    } else if (format_len == 3 && strncmp("+vl", format, 3) == 0) {
+        plan.kind = ArrowDecoderKind::ListView;
+    } else if (format_len == 3 && strncmp("+vL", format, 3) == 0) {
+        plan.kind = ArrowDecoderKind::LargeListView;
+    } else if (strncmp("+w:", format, 3) == 0) {
+        if (parse_arrow_decoder_plan_uint(&format[3], plan.fixed_size)) {
+            plan.kind = ArrowDecoderKind::FixedSizeList;
+        }
+    } else if (strncmp("w:", format, 2) == 0) {
+        if (parse_arrow_decoder_plan_uint(&format[2], plan.fixed_size)) {
+            plan.kind = ArrowDecoderKind::FixedSizeBinary;
+        }
+    } else if (format_len > 4 && strncmp("+ud:", format, 4) == 0) {
+        plan.kind = ArrowDecoderKind::DenseUnion;
+    } else if (format_len > 4 && strncmp("+us:", format, 4) == 0) {
+        plan.kind = ArrowDecoderKind::SparseUnion;
+    } else if (strncmp("d:", format, 2) == 0) {
+        // format should match `d:P,S[,N]`
+        // where P is precision, S is scale, N is bits
+        // N is optional and defaults to 128
+        int * d[3] = {&plan.precision, &plan.scale, &plan.bits};
+        int index = 0;
+        for (size_t i = 2; i < format_len; i++) {
+            if (format[i] == ',') {
+                if (index < 2) {
+                    index++;
+                    continue;
+                }
+                return;
+            }
+            *d[index] = *d[index] * 10 + (format[i] - '0');
+        }
+        if (plan.bits == 0) plan.bits = 128;
+        plan.kind = ArrowDecoderKind::Decimal;
+    }
+}
+
+static void compile_arrow_decoder_plan(const struct ArrowSchema * schema, ArrowDecoderPlan &plan) {
+    compile_arrow_decoder_plan_format(schema->format ? schema->format : "", plan);
+
+    plan.children.clear();
+    if (schema->n_children > 0 && schema->children != nullptr) {
+        plan.children.resize(schema->n_children);
+        for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+            if (schema->children[child_i] != nullptr) {
+                compile_arrow_decoder_plan(schema->children[child_i], plan.children[child_i]);
+            }
+        }
+    }
+
+    plan.dictionary.reset();
+    if (schema->dictionary != nullptr) {
+        plan.dictionary.reset(new ArrowDecoderPlan());
+        compile_arrow_decoder_plan(schema->dictionary, *plan.dictionary);
+    }
+}
+
+/// Whether arrays of `plan` are decoded into one term per row, as opposed
+/// to a term for the whole array (nulls), its children as columns (structs,
+/// maps, unions...), or the parts of their encoding (dictionaries, run-end
+/// encoded and list view arrays)
+static bool is_arrow_decoder_plan_row_wise(const ArrowDecoderPlan &plan) {
+    if (plan.dictionary != nullptr) {
+        return false;
+    }
+    switch (plan.kind) {
+        case ArrowDecoderKind::Unsupported:
+        case ArrowDecoderKind::Null:
+        case ArrowDecoderKind::Struct:
+        case ArrowDecoderKind::Map:
+        case ArrowDecoderKind::ListView:
+        case ArrowDecoderKind::LargeListView:
+        case ArrowDecoderKind::DenseUnion:
+        case ArrowDecoderKind::SparseUnion:
+        case ArrowDecoderKind::RunEndEncoded:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/// Moves `schema` into a new plan and compiles the plan for it. On success
+/// `schema->release` is cleared and the plan releases the schema once its
+/// last reference is gone, so the caller must not release it. On allocation
+/// failure nullptr is returned and `schema` is left to the caller.
+static SharedArrowDecoderPlan * new_shared_arrow_stream_plan(struct ArrowSchema * schema) {
+    auto plan = new (std::nothrow) SharedArrowDecoderPlan();
+    if (plan == nullptr) return nullptr;
+    memcpy(&plan->schema, schema, sizeof(struct ArrowSchema));
+    schema->release = nullptr;
+    compile_arrow_decoder_plan(&plan->schema, plan->root);
+    return plan;
+}
+
+static void keep_shared_arrow_decoder_plan(SharedArrowDecoderPlan * plan) {
+    if (plan) plan->refcount.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void release_shared_arrow_decoder_plan(SharedArrowDecoderPlan * plan) {
+    if (plan && plan->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete plan;
+    }
+}
+
+#endif  // ADBC_ARROW_DECODER_PLAN_HPP
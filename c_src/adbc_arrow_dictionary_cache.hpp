@@ -0,0 +1,141 @@
+#ifndef ADBC_ARROW_DICTIONARY_CACHE_HPP
+#define ADBC_ARROW_DICTIONARY_CACHE_HPP
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <arrow-adbc/adbc.h>
+#include <erl_nif.h>
+
+/// Decoded values of the dictionaries of a stream, so that a dictionary
+/// shared by many batches (or decoded again by a later materialization)
+/// is only turned into terms once.
+///
+/// Entries are keyed by the plan node and the decode options the values
+/// were decoded with, and by the buffers of the dictionary array, which stay
+/// valid for as long as a record holding that array is alive: records
+/// evict the entries of their dictionary when they are released, before
+/// the buffers can be freed and their addresses reused.
+///
+/// The terms live in a process independent environment and are copied
+/// into the environment of the caller on lookup.
+struct ArrowDictionaryCache {
+    struct Entry {
+        const void * node;
+        // the decode options that shape the values, see `get`
+        uint32_t flags;
+        const void * buffers[3];
+        int64_t length;
+        int64_t offset;
+        ERL_NIF_TERM values;
+    };
+
+    // the environment is cleared once this many entries were added to it,
+    // since the terms of evicted entries are only freed by clearing it
+    static constexpr size_t kMaxInserted = 64;
+
+    ErlNifMutex * mutex = nullptr;
+    ErlNifEnv * env = nullptr;
+    std::vector<Entry> entries;
+    size_t inserted = 0;
+
+    ArrowDictionaryCache() {
+        this->mutex = enif_mutex_create((char *)"adbc_dictionary_cache_mutex");
+    }
+
+    ~ArrowDictionaryCache() {
+        if (this->env) enif_free_env(this->env);
+        if (this->mutex) enif_mutex_destroy(this->mutex);
+    }
+
+    /// Only dictionaries without children or a dictionary of their own
+    /// can be identified by their buffers
+    static bool is_cacheable(const struct ArrowArray * dictionary) {
+        return dictionary != nullptr && dictionary->n_children == 0 && dictionary->dictionary == nullptr && dictionary->n_buffers <= 3;
+    }
+
+    /// Copies the values cached for `dictionary` (decoded with the plan
+    /// `node` and the options summarized by `flags`) into `env`.
+    /// @return true if found
+    bool get(ErlNifEnv * env, const void * node, uint32_t flags, const struct ArrowArray * dictionary, ERL_NIF_TERM &values) {
+        if (this->mutex == nullptr || !is_cacheable(dictionary)) return false;
+
+        bool found = false;
+        enif_mutex_lock(this->mutex);
+        for (auto &entry : this->entries) {
+            if (entry.node == node && entry.flags == flags && matches(entry, dictionary)) {
+                values = enif_make_copy(env, entry.values);
+                found = true;
+                break;
+            }
+        }
+        enif_mutex_unlock(this->mutex);
+        return found;
+    }
+
+    void put(const void * node, uint32_t flags, const struct ArrowArray * dictionary, ERL_NIF_TERM values) {
+        if (this->mutex == nullptr || !is_cacheable(dictionary)) return;
+
+        enif_mutex_lock(this->mutex);
+        if (this->inserted >= kMaxInserted) {
+            this->clear();
+        }
+        if (this->env == nullptr) {
+            this->env = enif_alloc_env();
+        }
+        if (this->env != nullptr) {
+            Entry entry{};
+            entry.node = node;
+            entry.flags = flags;
+            for (int64_t i = 0; i < dictionary->n_buffers; i++) {
+                entry.buffers[i] = dictionary->buffers[i];
+            }
+            entry.length = dictionary->length;
+            entry.offset = dictionary->offset;
+            entry.values = enif_make_copy(this->env, values);
+            this->entries.push_back(entry);
+            this->inserted++;
+        }
+        enif_mutex_unlock(this->mutex);
+    }
+
+    /// Drops the entries of `dictionary`, whose buffers are about to be released
+    void evict(const struct ArrowArray * dictionary) {
+        if (this->mutex == nullptr || !is_cacheable(dictionary)) return;
+
+        enif_mutex_lock(this->mutex);
+        for (size_t i = 0; i < this->entries.size();) {
+            if (matches(this->entries[i], dictionary)) {
+                this->entries[i] = this->entries.back();
+                this->entries.pop_back();
+            } else {
+                i++;
+            }
+        }
+        if (this->entries.empty() && this->inserted > 0) {
+            this->clear();
+        }
+        enif_mutex_unlock(this->mutex);
+    }
+
+private:
+    static bool matches(const Entry &entry, const struct ArrowArray * dictionary) {
+        if (entry.length != dictionary->length || entry.offset != dictionary->offset) {
+            return false;
+        }
+        for (int64_t i = 0; i < 3; i++) {
+            const void * buffer = i < dictionary->n_buffers ? dictionary->buffers[i] : nullptr;
+            if (entry.buffers[i] != buffer) return false;
+        }
+        return true;
+    }
+
+    // must be called with `mutex` held
+    void clear() {
+        this->entries.clear();
+        this->inserted = 0;
+        if (this->env) enif_clear_env(this->env);
+    }
+};
+
+#endif  // ADBC_ARROW_DICTIONARY_CACHE_HPP
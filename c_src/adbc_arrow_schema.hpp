@@ -11,12 +11,13 @@
 #include <erl_nif.h>
 #include "adbc_consts.h"
 #include "adbc_arrow_metadata.hpp"
+#include "adbc_arrow_decoder_plan.hpp"
 #include "adbc_column.hpp"
 #include "nif_utils.hpp"
 
-static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error);
+static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &value_type, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error);
 
-static int get_struct_schema(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
+static int get_struct_schema(ErlNifEnv *env, struct ArrowSchema * schema, uint64_t level, std::vector<ERL_NIF_TERM> &children, ERL_NIF_TERM &error) {
     if (schema->n_children > 0 && schema->children == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr while schema->n_children > 0");
         return 1;
@@ -27,30 +28,10 @@ static int get_struct_schema(ErlNifEnv *env, struct ArrowSchema * schema, struct
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_schema_to_nif_term(env, child_schema, nullptr, level + 1, childrens, child_type, child_metadata, error) != 0) {
+        if (arrow_schema_to_nif_term(env, child_schema, level + 1, childrens, child_type, child_metadata, error) != 0) {
             return 1;
         }
-
-        if (level == 0) {
-            using record_type = NifRes<struct ArrowArrayStreamRecord>;
-            auto * record = record_type::allocate_resource(env, error);
-            if (record == nullptr) {
-                return 1;
-            }
-            if (record->val.allocate_schema_and_values()) {
-                error = erlang::nif::error(env, "out of memory");
-                return 1;
-            }
-            struct ArrowArray * child_array = array->children[child_i];
-            ArrowSchemaDeepCopy(child_schema, record->val.schema);
-            ArrowArrayMove(child_array, record->val.values);
-            memset(array->children[child_i], 0, sizeof(struct ArrowArray));
-            ERL_NIF_TERM data_ref = record->make_resource(env);
-
-            children[child_i] = make_adbc_column(env, child_schema, child_type, child_metadata, data_ref);
-        } else {
-            children[child_i] = make_adbc_column(env, child_schema, child_type, child_metadata);
-        }
+        children[child_i] = make_adbc_column(env, child_schema, child_type, child_metadata);
     }
 
     return 0;
@@ -75,7 +56,7 @@ static int get_run_end_encoded_schema(ErlNifEnv *env, struct ArrowSchema * schem
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_schema_to_nif_term(env, schema->children[child_i], nullptr, level + 1, childrens, child_type, child_metadata, error) != 0) {
+        if (arrow_schema_to_nif_term(env, schema->children[child_i], level + 1, childrens, child_type, child_metadata, error) != 0) {
             return 1;
         }
 
@@ -118,14 +99,14 @@ static int get_map_schema(ErlNifEnv *env, struct ArrowSchema * schema, uint64_t
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
         if (strcmp("key", entry_schema->name) == 0) {
-            if (arrow_schema_to_nif_term(env, entry_schema, nullptr, level + 1, childrens, child_type, child_metadata, error) != 0) {
+            if (arrow_schema_to_nif_term(env, entry_schema, level + 1, childrens, child_type, child_metadata, error) != 0) {
                 return 1;
             }
 
             key_schema = make_adbc_column(env, entry_schema, child_type, child_metadata);
             kv |= 0x1;
         } else if (strcmp("value", entry_schema->name) == 0) {
-            if (arrow_schema_to_nif_term(env, entry_schema, nullptr, level + 1, childrens, child_type, child_metadata, error) != 0) {
+            if (arrow_schema_to_nif_term(env, entry_schema, level + 1, childrens, child_type, child_metadata, error) != 0) {
                 return 1;
             }
 
@@ -164,7 +145,7 @@ static int get_list_element_schema(ErlNifEnv *env, struct ArrowSchema * schema,
     std::vector<ERL_NIF_TERM> childrens;
     ERL_NIF_TERM child_type;
     ERL_NIF_TERM child_metadata;
-    if (arrow_schema_to_nif_term(env, items_schema, nullptr, level + 1, childrens, child_type, child_metadata, error) != 0) {
+    if (arrow_schema_to_nif_term(env, items_schema, level + 1, childrens, child_type, child_metadata, error) != 0) {
         return 1;
     }
 
@@ -174,21 +155,11 @@ static int get_list_element_schema(ErlNifEnv *env, struct ArrowSchema * schema,
     return 0;
 }
 
-static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &error) {
-    ERL_NIF_TERM type_term, metadata;
-    int level = 0;
-    return arrow_schema_to_nif_term(env, schema, array, level, out_terms, type_term, metadata, error);
-}
-
-static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, struct ArrowArray * array, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &type_term, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error) {
+static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema, uint64_t level, std::vector<ERL_NIF_TERM> &out_terms, ERL_NIF_TERM &type_term, ERL_NIF_TERM &metadata, ERL_NIF_TERM &error) {
     if (schema == nullptr) {
         error = erlang::nif::error(env, "invalid ArrowSchema (nullptr) when invoking next");
         return 1;
     }
-    if (level == 0 && array == nullptr) {
-        error = erlang::nif::error(env, "invalid ArrowArray (nullptr) is nullptr at top-level entry");
-        return 1;
-    }
 
     char err_msg_buf[256] = { '\0' };
     const char* format = schema->format ? schema->format : "";
@@ -214,7 +185,7 @@ static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema,
         std::vector<ERL_NIF_TERM> childrens;
         ERL_NIF_TERM child_type;
         ERL_NIF_TERM child_metadata;
-        if (arrow_schema_to_nif_term(env, schema->dictionary, nullptr, level + 1, childrens, child_type, child_metadata, error) != 0) {
+        if (arrow_schema_to_nif_term(env, schema->dictionary, level + 1, childrens, child_type, child_metadata, error) != 0) {
             return 1;
         }
 
@@ -239,7 +210,7 @@ static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema,
     } else if (format_len == 2) {
         if (strncmp("+s", format, 2) == 0) {
             // NANOARROW_TYPE_STRUCT
-            if (get_struct_schema(env, schema, array, level, children, error) != 0) {
+            if (get_struct_schema(env, schema, level, children, error) != 0) {
                 return 1;
             }
 
@@ -443,4 +414,69 @@ static int arrow_schema_to_nif_term(ErlNifEnv *env, struct ArrowSchema * schema,
     return 0;
 }
 
+/// Builds the `%Adbc.Column{}` of every child of a stream's (struct) schema
+/// with `data: nil`, so that they only have to be built once per stream.
+static int arrow_schema_to_column_terms(ErlNifEnv *env, struct ArrowSchema * schema, ERL_NIF_TERM &columns, ERL_NIF_TERM &error) {
+    if (schema->n_children > 0 && schema->children == nullptr) {
+        error = erlang::nif::error(env, "invalid ArrowSchema, schema->children == nullptr while schema->n_children > 0");
+        return 1;
+    }
+
+    std::vector<ERL_NIF_TERM> children(schema->n_children);
+    for (int64_t child_i = 0; child_i < schema->n_children; child_i++) {
+        struct ArrowSchema * child_schema = schema->children[child_i];
+        std::vector<ERL_NIF_TERM> childrens;
+        ERL_NIF_TERM child_type;
+        ERL_NIF_TERM child_metadata;
+        if (arrow_schema_to_nif_term(env, child_schema, 1, childrens, child_type, child_metadata, error) != 0) {
+            return 1;
+        }
+        children[child_i] = make_adbc_column(env, child_schema, child_type, child_metadata);
+    }
+
+    columns = enif_make_list_from_array(env, children.data(), (unsigned)children.size());
+    return 0;
+}
+
+/// Moves every child of a batch into a record that borrows its schema from
+/// `plan`, and returns `columns` (see `arrow_schema_to_column_terms`) with
+/// their `data` set to the record.
+static int arrow_array_to_column_terms(ErlNifEnv *env, SharedArrowDecoderPlan * plan, ERL_NIF_TERM columns, struct ArrowArray * array, ERL_NIF_TERM &out, ERL_NIF_TERM &error) {
+    if (array->n_children != plan->schema.n_children || (array->n_children > 0 && array->children == nullptr)) {
+        error = erlang::nif::error(env, "invalid ArrowArray, its children do not match the ArrowSchema of the stream");
+        return 1;
+    }
+    if ((int64_t)plan->root.children.size() != plan->schema.n_children) {
+        error = erlang::nif::error(env, "invalid decoder plan, its children do not match the ArrowSchema");
+        return 1;
+    }
+
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    std::vector<ERL_NIF_TERM> children;
+    children.reserve(array->n_children);
+    ERL_NIF_TERM column;
+    for (int64_t child_i = 0; enif_get_list_cell(env, columns, &column, &columns); child_i++) {
+        auto * record = record_type::allocate_resource(env, error);
+        if (record == nullptr) {
+            return 1;
+        }
+        if (record->val.allocate_values_with_stream_schema(plan, child_i)) {
+            error = erlang::nif::error(env, "out of memory");
+            return 1;
+        }
+        ArrowArrayMove(array->children[child_i], record->val.values);
+        ERL_NIF_TERM data_ref = enif_make_list1(env, record->make_resource(env));
+
+        ERL_NIF_TERM updated;
+        if (!enif_make_map_update(env, column, kAtomDataKey, data_ref, &updated)) {
+            error = erlang::nif::error(env, "invalid column term");
+            return 1;
+        }
+        children.emplace_back(updated);
+    }
+
+    out = enif_make_list_from_array(env, children.data(), (unsigned)children.size());
+    return 0;
+}
+
 #endif  // ADBC_ARROW_ARRAY_HPP
@@ -0,0 +1,95 @@
+#ifndef ADBC_CIVIL_TIME_HPP
+#define ADBC_CIVIL_TIME_HPP
+#pragma once
+
+#include <cstdint>
+
+// Calendar conversions in pure integer arithmetic.
+//
+// The temporal decoders and encoders use these instead of gmtime/mktime: they
+// do not touch libc's static `struct tm` buffer (so they are safe on concurrent
+// dirty schedulers), do not depend on the host timezone, and handle dates
+// before 1970-01-01.
+//
+// The day <-> civil date algorithms are the proleptic Gregorian ones from
+// Howard Hinnant, http://howardhinnant.github.io/date_algorithms.html
+
+constexpr int64_t kSecondsPerDay = 24 * 60 * 60;
+constexpr int64_t kMicrosecondsPerSecond = 1000000;
+constexpr int64_t kMicrosecondsPerDay = kSecondsPerDay * kMicrosecondsPerSecond;
+
+struct CivilDate {
+    int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+struct CivilTime {
+    unsigned hour;
+    unsigned minute;
+    unsigned second;
+    unsigned microsecond;
+};
+
+/// Division rounding towards negative infinity
+static inline int64_t civil_floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+    return q;
+}
+
+/// Modulo with the sign of the divisor, so that
+/// `a == civil_floor_div(a, b) * b + civil_floor_mod(a, b)`
+static inline int64_t civil_floor_mod(int64_t a, int64_t b) {
+    return a - civil_floor_div(a, b) * b;
+}
+
+/// Converts days since 1970-01-01 to a civil date
+static inline CivilDate civil_from_days(int64_t days) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned doe = (unsigned)(days - era * 146097);                      // [0, 146096]
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);               // [0, 365]
+    const unsigned mp = (5 * doy + 2) / 153;                                    // [0, 11]
+    const unsigned day = doy - (153 * mp + 2) / 5 + 1;                          // [1, 31]
+    const unsigned month = mp < 10 ? mp + 3 : mp - 9;                           // [1, 12]
+    const int64_t year = (int64_t)yoe + era * 400 + (month <= 2);
+    return {year, month, day};
+}
+
+/// Converts a civil date to days since 1970-01-01
+static inline int64_t days_from_civil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = (unsigned)(year - era * 400);                             // [0, 399]
+    const unsigned doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;  // [0, 365]
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                      // [0, 146096]
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+/// Converts microseconds since midnight to a time of the day,
+/// values outside of a day wrap around
+static inline CivilTime civil_time_from_microseconds(int64_t us) {
+    us = civil_floor_mod(us, kMicrosecondsPerDay);
+    unsigned seconds = (unsigned)(us / kMicrosecondsPerSecond);
+    return {
+        seconds / 3600,
+        (seconds / 60) % 60,
+        seconds % 60,
+        (unsigned)(us % kMicrosecondsPerSecond),
+    };
+}
+
+/// Converts a value in `unit` ('s', 'm', 'u' or 'n') to microseconds,
+/// nanoseconds are truncated towards negative infinity
+static inline int64_t civil_microseconds_from_unit(int64_t val, char unit) {
+    switch (unit) {
+        case 's': return val * kMicrosecondsPerSecond;
+        case 'm': return val * 1000;
+        case 'u': return val;
+        default: return civil_floor_div(val, 1000);
+    }
+}
+
+#endif  // ADBC_CIVIL_TIME_HPP
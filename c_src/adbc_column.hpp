@@ -1,7 +1,6 @@
 #ifndef ADBC_COLUMN_HPP
 #pragma once
 
-#include <time.h>
 #include <cstdbool>
 #include <cstdint>
 #include <functional>
@@ -13,6 +12,7 @@
 #include "adbc_consts.h"
 #include "adbc_half_float.hpp"
 #include "nif_utils.hpp"
+#include "adbc_civil_time.hpp"
 
 struct AdbcColumnType {
     int valid = 0;
@@ -49,6 +49,8 @@ struct AdbcColumnNifTerm {
     int is_nil;
     unsigned n_items;
     ERL_NIF_TERM struct_name_term, name_term, type_term, nullable_term, metadata_term, data_term;
+    // only read for run-end encoded columns, `nil` otherwise
+    ERL_NIF_TERM offset_term;
     static int from_term(ErlNifEnv *env, ERL_NIF_TERM adbc_column, bool allow_nil, AdbcColumnNifTerm *out);
 };
 
@@ -93,6 +95,10 @@ int AdbcColumnNifTerm::from_term(ErlNifEnv *env, ERL_NIF_TERM adbc_column, bool
         out->nullable_term = nullable_term;
         out->metadata_term = metadata_term;
         out->data_term = data_term;
+        out->offset_term = kAtomNil;
+        if (enif_is_identical(type_term, kAdbcColumnTypeRunEndEncoded)) {
+            enif_get_map_value(env, adbc_column, kAtomOffsetKey, &out->offset_term);
+        }
     }
 
     return 0;
@@ -405,6 +411,74 @@ failed:
     return ret;
 }
 
+// Builds a run-end encoded array from `%{run_ends: column, values: column}`,
+// taking its logical length and offset from the `length` and `offset` fields
+// of the column. Arrow checks the run ends when the parent array is finished.
+int do_get_run_end_encoded(ErlNifEnv *env, struct AdbcColumnNifTerm * column, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+    ERL_NIF_TERM run_ends_term, values_term;
+    if (!enif_get_map_value(env, column->data_term, kAtomRunEnds, &run_ends_term)) {
+        return kErrorBufferGetMapValue;
+    }
+    if (!enif_get_map_value(env, column->data_term, kAtomValues, &values_term)) {
+        return kErrorBufferGetMapValue;
+    }
+
+    struct AdbcColumnNifTerm run_ends, values;
+    int ret = AdbcColumnNifTerm::from_term(env, run_ends_term, false, &run_ends);
+    if (ret != 0) return ret;
+    ret = AdbcColumnNifTerm::from_term(env, values_term, false, &values);
+    if (ret != 0) return ret;
+
+    struct AdbcColumnType run_end_type = adbc_column_type_to_nanoarrow_type(env, run_ends.type_term);
+    if (!run_end_type.valid ||
+        (run_end_type.arrow_type != NANOARROW_TYPE_INT16 &&
+         run_end_type.arrow_type != NANOARROW_TYPE_INT32 &&
+         run_end_type.arrow_type != NANOARROW_TYPE_INT64)) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected the run ends of run-end encoded `Adbc.Column` to be :s16, :s32 or :s64.");
+        return kErrorBufferRunEndEncoded;
+    }
+
+    ErlNifSInt64 offset = 0;
+    if (!enif_is_identical(column->offset_term, kAtomNil) && (!enif_get_int64(env, column->offset_term, &offset) || offset < 0)) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected the `offset` of run-end encoded `Adbc.Column` to be a non-negative integer or nil.");
+        return kErrorBufferRunEndEncoded;
+    }
+
+    struct AdbcColumnNifTerm * children[2] = { &run_ends, &values };
+    const char * names[2] = { "run_ends", "values" };
+
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetFormat(schema_out, "+r"));
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaAllocateChildren(schema_out, 2));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromType(array_out, NANOARROW_TYPE_RUN_END_ENCODED));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAllocateChildren(array_out, 2));
+
+    for (int i = 0; i < 2; i++) {
+        ret = adbc_column_to_adbc_field(env, children[i], false, false, array_out->children[i], schema_out->children[i], error_out);
+        if (ret != 0) {
+            goto failed;
+        }
+        ret = ArrowSchemaSetName(schema_out->children[i], names[i]);
+        if (ret != 0) {
+            goto failed;
+        }
+    }
+
+    array_out->length = column->n_items;
+    array_out->offset = offset;
+    return 0;
+
+failed:
+    if (schema_out->release != nullptr) {
+        schema_out->release(schema_out);
+        schema_out->release = nullptr;
+    }
+    if (array_out->release != nullptr) {
+        array_out->release(array_out);
+        array_out->release = nullptr;
+    }
+    return ret;
+}
+
 int get_list_string(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray * write_array, const std::function<int(struct ArrowArray *, struct ArrowStringView val)> &callback) {
     ERL_NIF_TERM head, tail;
     tail = list;
@@ -505,16 +579,109 @@ int do_get_list_fixed_size_binary(ErlNifEnv *env, ERL_NIF_TERM list, bool nullab
     return ret;
 }
 
-int get_utc_offset() {
-    time_t zero = 24 * 60 * 60L;
-    struct tm * timeptr;
-    int gmtime_hours;
-    timeptr = localtime(&zero);
-    gmtime_hours = timeptr->tm_hour;
-    if (timeptr->tm_mday < 2) {
-        gmtime_hours -= 24;
+// Fields of Date, Time and NaiveDateTime structs
+struct ExCalendarFields {
+    enum : unsigned {
+        kStruct = 1 << 0,
+        kCalendar = 1 << 1,
+        kYear = 1 << 2,
+        kMonth = 1 << 3,
+        kDay = 1 << 4,
+        kHour = 1 << 5,
+        kMinute = 1 << 6,
+        kSecond = 1 << 7,
+        kMicrosecond = 1 << 8,
+    };
+
+    unsigned found = 0;
+    ERL_NIF_TERM struct_name, calendar, year, month, day, hour, minute, second, microsecond;
+};
+
+// Reads the calendar fields of a struct in a single pass over the map
+// instead of one `enif_get_map_value` lookup per field.
+//
+// Returns 0 if `map` is a `module` struct with an ISO calendar and all of the
+// `required` fields, otherwise the same error codes as the lookups did.
+int get_ex_calendar_fields(ErlNifEnv *env, ERL_NIF_TERM map, ERL_NIF_TERM module, unsigned required, ExCalendarFields &fields) {
+    ErlNifMapIterator iter;
+    if (!enif_map_iterator_create(env, map, &iter, ERL_NIF_MAP_ITERATOR_FIRST)) {
+        return kErrorBufferGetMapValue;
+    }
+
+    ERL_NIF_TERM key, value;
+    while (enif_map_iterator_get_pair(env, &iter, &key, &value)) {
+        if (enif_is_identical(key, kAtomStructKey)) {
+            fields.struct_name = value;
+            fields.found |= ExCalendarFields::kStruct;
+        } else if (enif_is_identical(key, kAtomCalendarKey)) {
+            fields.calendar = value;
+            fields.found |= ExCalendarFields::kCalendar;
+        } else if (enif_is_identical(key, kAtomYearKey)) {
+            fields.year = value;
+            fields.found |= ExCalendarFields::kYear;
+        } else if (enif_is_identical(key, kAtomMonthKey)) {
+            fields.month = value;
+            fields.found |= ExCalendarFields::kMonth;
+        } else if (enif_is_identical(key, kAtomDayKey)) {
+            fields.day = value;
+            fields.found |= ExCalendarFields::kDay;
+        } else if (enif_is_identical(key, kAtomHourKey)) {
+            fields.hour = value;
+            fields.found |= ExCalendarFields::kHour;
+        } else if (enif_is_identical(key, kAtomMinuteKey)) {
+            fields.minute = value;
+            fields.found |= ExCalendarFields::kMinute;
+        } else if (enif_is_identical(key, kAtomSecondKey)) {
+            fields.second = value;
+            fields.found |= ExCalendarFields::kSecond;
+        } else if (enif_is_identical(key, kAtomMicrosecondKey)) {
+            fields.microsecond = value;
+            fields.found |= ExCalendarFields::kMicrosecond;
+        }
+        enif_map_iterator_next(env, &iter);
+    }
+    enif_map_iterator_destroy(env, &iter);
+
+    if (!(fields.found & ExCalendarFields::kStruct)) {
+        return kErrorBufferGetMapValue;
     }
-    return gmtime_hours;
+    if (!enif_is_identical(fields.struct_name, module)) {
+        return kErrorBufferWrongStruct;
+    }
+    if (!(fields.found & ExCalendarFields::kCalendar)) {
+        return kErrorBufferGetMapValue;
+    }
+    if (!enif_is_identical(fields.calendar, kAtomCalendarISO)) {
+        return kErrorExpectedCalendarISO;
+    }
+    if ((fields.found & required) != required) {
+        return kErrorBufferGetMapValue;
+    }
+    return 0;
+}
+
+// Reads `{microsecond, precision}`, returns false on failure
+bool get_ex_microsecond(ErlNifEnv *env, ERL_NIF_TERM microsecond_term, int64_t &us) {
+    const ERL_NIF_TERM *us_tuple = nullptr;
+    int us_arity;
+    int us_precision;
+    if (!enif_get_tuple(env, microsecond_term, &us_arity, &us_tuple) || us_arity != 2) {
+        return false;
+    }
+    return erlang::nif::get(env, us_tuple[0], &us) && erlang::nif::get(env, us_tuple[1], &us_precision);
+}
+
+// Converts seconds and microseconds to a value in `unit`,
+// which is the number of nanoseconds in one unit
+int64_t ex_time_to_unit(int64_t seconds, int64_t us, enum ArrowTimeUnit time_unit, uint64_t unit) {
+    if (time_unit == NANOARROW_TIME_UNIT_SECOND) {
+        return seconds;
+    }
+    int64_t total_us = seconds * kMicrosecondsPerSecond + us;
+    if (unit >= 1000) {
+        return civil_floor_div(total_us, (int64_t)(unit / 1000));
+    }
+    return total_us * (int64_t)(1000 / unit);
 }
 
 int get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
@@ -532,40 +699,19 @@ int get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Arrow
             if (erlang::nif::get(env, head, &val)) {
                 NANOARROW_RETURN_NOT_OK(callback(write_array, val));
             } else if (enif_is_map(env, head)) {
-                ERL_NIF_TERM struct_name_term, calendar_term, year_term, month_term, day_term;
-                if (!enif_get_map_value(env, head, kAtomStructKey, &struct_name_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_is_identical(struct_name_term, kAtomDateModule)) {
-                    return kErrorBufferWrongStruct;
-                }
-
-                if (!enif_get_map_value(env, head, kAtomCalendarKey, &calendar_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_is_identical(calendar_term, kAtomCalendarISO)) {
-                    return kErrorExpectedCalendarISO;
-                }
-
-                if (!enif_get_map_value(env, head, kAtomYearKey, &year_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_get_map_value(env, head, kAtomMonthKey, &month_term)) {
-                    return kErrorBufferGetMapValue;
-                }
-                if (!enif_get_map_value(env, head, kAtomDayKey, &day_term)) {
-                    return kErrorBufferGetMapValue;
+                ExCalendarFields fields;
+                constexpr unsigned required = ExCalendarFields::kYear | ExCalendarFields::kMonth | ExCalendarFields::kDay;
+                int ret = get_ex_calendar_fields(env, head, kAtomDateModule, required, fields);
+                if (ret != 0) {
+                    return ret;
                 }
 
-                tm time{};
-                if (!erlang::nif::get(env, year_term, &time.tm_year) || !erlang::nif::get(env, month_term, &time.tm_mon) || !erlang::nif::get(env, day_term, &time.tm_mday)) {
+                int64_t year;
+                unsigned month, day;
+                if (!erlang::nif::get(env, fields.year, &year) || !erlang::nif::get(env, fields.month, &month) || !erlang::nif::get(env, fields.day, &day)) {
                     return kErrorBufferGetMapValue;
                 }
-                time.tm_year -= 1900;
-                time.tm_mon -= 1;
-                // mktime always gives local time
-                // so we need to adjust it to UTC
-                val = mktime(&time) + get_utc_offset() * 3600;
+                val = days_from_civil(year, month, day) * kSecondsPerDay;
                 NANOARROW_RETURN_NOT_OK(callback(write_array, normalize_ex_value(val)));
             } else {
                 return 1;
@@ -601,7 +747,7 @@ int do_get_list_date(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType
     return ret;
 }
 
-int get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t, uint64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
+int get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t, int64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
@@ -609,51 +755,22 @@ int get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct Arrow
         if (erlang::nif::get(env, head, &val)) {
             NANOARROW_RETURN_NOT_OK(callback(write_array, val));
         } else if (enif_is_map(env, head)) {
-            ERL_NIF_TERM struct_name_term, calendar_term, hour_term, minute_term, second_term, microsecond_term;
-            if (!enif_get_map_value(env, head, kAtomStructKey, &struct_name_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(struct_name_term, kAtomTimeModule)) {
-                return kErrorBufferWrongStruct;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomCalendarKey, &calendar_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(calendar_term, kAtomCalendarISO)) {
-                return kErrorExpectedCalendarISO;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomHourKey, &hour_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMinuteKey, &minute_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomSecondKey, &second_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMicrosecondKey, &microsecond_term)) {
-                return kErrorBufferGetMapValue;
-            }
-
-            tm time{};
-            if (!erlang::nif::get(env, hour_term, &time.tm_hour) || !erlang::nif::get(env, minute_term, &time.tm_min) || !erlang::nif::get(env, second_term, &time.tm_sec)) {
-                return kErrorBufferGetMapValue;
+            ExCalendarFields fields;
+            constexpr unsigned required = ExCalendarFields::kHour | ExCalendarFields::kMinute | ExCalendarFields::kSecond | ExCalendarFields::kMicrosecond;
+            int ret = get_ex_calendar_fields(env, head, kAtomTimeModule, required, fields);
+            if (ret != 0) {
+                return ret;
             }
 
-            const ERL_NIF_TERM *us_tuple = nullptr;
-            int us_arity;
-            uint64_t us;
-            int us_precision;
-            if (!enif_get_tuple(env, microsecond_term, &us_arity, &us_tuple) || us_arity != 2) {
+            int64_t hour, minute, second, us;
+            if (!erlang::nif::get(env, fields.hour, &hour) || !erlang::nif::get(env, fields.minute, &minute) || !erlang::nif::get(env, fields.second, &second)) {
                 return kErrorBufferGetMapValue;
             }
-            if (!erlang::nif::get(env, us_tuple[0], &us) || !erlang::nif::get(env, us_tuple[1], &us_precision)) {
+            if (!get_ex_microsecond(env, fields.microsecond, us)) {
                 return kErrorBufferGetMapValue;
             }
 
-            val = time.tm_hour * 3600 + time.tm_min * 60 + time.tm_sec;
+            val = hour * 3600 + minute * 60 + second;
             NANOARROW_RETURN_NOT_OK(callback(write_array, normalize_ex_value(val, us)));
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
             NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
@@ -671,12 +788,8 @@ int do_get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    auto normalize_ex_value = [=](int64_t val, uint64_t us) -> int64_t {
-        if (time_unit == NANOARROW_TIME_UNIT_SECOND) {
-            return val;
-        }
-        val = (val * 1000000 + us) * 1000 / unit;
-        return val;
+    auto normalize_ex_value = [=](int64_t val, int64_t us) -> int64_t {
+        return ex_time_to_unit(val, us, time_unit, unit);
     };
     int ret = get_list_time(env, list, nullable, write_array, normalize_ex_value, ArrowArrayAppendInt);
     if (ret == 0) {
@@ -686,7 +799,7 @@ int do_get_list_time(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, ArrowType
     return ret;
 }
 
-int get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t, uint64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
+int get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct ArrowArray* write_array, const std::function<int64_t(int64_t, int64_t)> &normalize_ex_value, const std::function<int(struct ArrowArray*, int64_t val)> &callback) {
     ERL_NIF_TERM head, tail;
     tail = list;
     while (enif_get_list_cell(env, tail, &head, &tail)) {
@@ -694,69 +807,29 @@ int get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct
         if (erlang::nif::get(env, head, &val)) {
             NANOARROW_RETURN_NOT_OK(callback(write_array, val));
         } else if (enif_is_map(env, head)) {
-            ERL_NIF_TERM struct_name_term, calendar_term, year_term, month_term, day_term, hour_term, minute_term, second_term, microsecond_term;
-            if (!enif_get_map_value(env, head, kAtomStructKey, &struct_name_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(struct_name_term, kAtomNaiveDateTimeModule)) {
-                return kErrorBufferWrongStruct;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomCalendarKey, &calendar_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_is_identical(calendar_term, kAtomCalendarISO)) {
-                return kErrorExpectedCalendarISO;
-            }
-
-            if (!enif_get_map_value(env, head, kAtomYearKey, &year_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMonthKey, &month_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomDayKey, &day_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomHourKey, &hour_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMinuteKey, &minute_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomSecondKey, &second_term)) {
-                return kErrorBufferGetMapValue;
-            }
-            if (!enif_get_map_value(env, head, kAtomMicrosecondKey, &microsecond_term)) {
-                return kErrorBufferGetMapValue;
-            }
-
-            tm time{};
-            if (!erlang::nif::get(env, year_term, &time.tm_year) ||
-                !erlang::nif::get(env, month_term, &time.tm_mon) ||
-                !erlang::nif::get(env, day_term, &time.tm_mday) ||
-                !erlang::nif::get(env, hour_term, &time.tm_hour) ||
-                !erlang::nif::get(env, minute_term, &time.tm_min) ||
-                !erlang::nif::get(env, second_term, &time.tm_sec)) {
-                return kErrorBufferGetMapValue;
+            ExCalendarFields fields;
+            constexpr unsigned required = ExCalendarFields::kYear | ExCalendarFields::kMonth | ExCalendarFields::kDay |
+                ExCalendarFields::kHour | ExCalendarFields::kMinute | ExCalendarFields::kSecond | ExCalendarFields::kMicrosecond;
+            int ret = get_ex_calendar_fields(env, head, kAtomNaiveDateTimeModule, required, fields);
+            if (ret != 0) {
+                return ret;
             }
 
-            const ERL_NIF_TERM *us_tuple = nullptr;
-            int us_arity;
-            uint64_t us;
-            int us_precision;
-            if (!enif_get_tuple(env, microsecond_term, &us_arity, &us_tuple) || us_arity != 2) {
+            int64_t year, hour, minute, second, us;
+            unsigned month, day;
+            if (!erlang::nif::get(env, fields.year, &year) ||
+                !erlang::nif::get(env, fields.month, &month) ||
+                !erlang::nif::get(env, fields.day, &day) ||
+                !erlang::nif::get(env, fields.hour, &hour) ||
+                !erlang::nif::get(env, fields.minute, &minute) ||
+                !erlang::nif::get(env, fields.second, &second)) {
                 return kErrorBufferGetMapValue;
             }
-            if (!erlang::nif::get(env, us_tuple[0], &us) || !erlang::nif::get(env, us_tuple[1], &us_precision)) {
+            if (!get_ex_microsecond(env, fields.microsecond, us)) {
                 return kErrorBufferGetMapValue;
             }
 
-            time.tm_year -= 1900;
-            time.tm_mon -= 1;
-            // mktime always gives local time
-            // so we need to adjust it to UTC
-            val = mktime(&time) + get_utc_offset() * 3600;
+            val = days_from_civil(year, month, day) * kSecondsPerDay + hour * 3600 + minute * 60 + second;
             NANOARROW_RETURN_NOT_OK(callback(write_array, normalize_ex_value(val, us)));
         } else if (nullable && enif_is_identical(head, kAtomNil)) {
             NANOARROW_RETURN_NOT_OK(ArrowArrayAppendNull(write_array, 1));
@@ -774,12 +847,8 @@ int do_get_list_timestamp(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, Arro
     struct ArrowArray* write_array = tmp.get();
     NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(write_array, schema_out, error_out));
     NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(write_array));
-    auto normalize_ex_value = [=](int64_t val, uint64_t us) -> int64_t {
-        if (time_unit == NANOARROW_TIME_UNIT_SECOND) {
-            return val;
-        }
-        val = (val * 1000000 + us) * 1000 / unit;
-        return val;
+    auto normalize_ex_value = [=](int64_t val, int64_t us) -> int64_t {
+        return ex_time_to_unit(val, us, time_unit, unit);
     };
     int ret = get_list_timestamp(env, list, nullable, write_array, normalize_ex_value, ArrowArrayAppendInt);
     if (ret == 0) {
@@ -1054,6 +1123,155 @@ int do_get_list(ErlNifEnv *env, ERL_NIF_TERM list, bool nullable, struct AdbcCol
     return 0;
 }
 
+// Byte width of the types that can be given as packed binaries,
+// 0 if the type has to be given as a list
+int64_t packed_value_bytes(ArrowType type) {
+    switch (type) {
+        case NANOARROW_TYPE_INT8:
+        case NANOARROW_TYPE_UINT8:
+            return 1;
+        case NANOARROW_TYPE_INT16:
+        case NANOARROW_TYPE_UINT16:
+        case NANOARROW_TYPE_HALF_FLOAT:
+            return 2;
+        case NANOARROW_TYPE_INT32:
+        case NANOARROW_TYPE_UINT32:
+        case NANOARROW_TYPE_FLOAT:
+        case NANOARROW_TYPE_DATE32:
+        case NANOARROW_TYPE_TIME32:
+            return 4;
+        case NANOARROW_TYPE_INT64:
+        case NANOARROW_TYPE_UINT64:
+        case NANOARROW_TYPE_DOUBLE:
+        case NANOARROW_TYPE_DATE64:
+        case NANOARROW_TYPE_TIME64:
+        case NANOARROW_TYPE_TIMESTAMP:
+        case NANOARROW_TYPE_DURATION:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+void free_packed_binary_env(struct ArrowBufferAllocator * allocator, uint8_t * ptr, int64_t size) {
+    enif_free_env((ErlNifEnv *)allocator->private_data);
+}
+
+// Points `buffer` at the bytes of `binary_term` without copying them.
+//
+// The binary is copied into its own environment first, which holds a
+// reference to it (heap binaries are small and get copied) for as long as
+// the buffer lives, and the environment is freed by the buffer's deallocator.
+//
+// Sub-binaries, such as the ones made by `binary_part/3` or by matching,
+// may start at any byte, so bytes not aligned to `alignment` are copied
+// into a buffer of their own instead.
+int wrap_packed_binary(ErlNifEnv *env, ERL_NIF_TERM binary_term, int64_t alignment, struct ArrowBuffer * buffer) {
+    ErlNifEnv * owner = enif_alloc_env();
+    if (owner == nullptr) {
+        return ENOMEM;
+    }
+
+    ErlNifBinary bytes;
+    ERL_NIF_TERM owned = enif_make_copy(owner, binary_term);
+    if (!enif_inspect_binary(owner, owned, &bytes)) {
+        enif_free_env(owner);
+        return EINVAL;
+    }
+
+    if (reinterpret_cast<uintptr_t>(bytes.data) % (uintptr_t)alignment != 0) {
+        int ret = ArrowBufferAppend(buffer, bytes.data, (int64_t)bytes.size);
+        enif_free_env(owner);
+        return ret;
+    }
+
+    int ret = ArrowBufferSetAllocator(buffer, ArrowBufferDeallocator(free_packed_binary_env, owner));
+    if (ret != NANOARROW_OK) {
+        enif_free_env(owner);
+        return ret;
+    }
+    buffer->data = bytes.data;
+    buffer->size_bytes = (int64_t)bytes.size;
+    buffer->capacity_bytes = (int64_t)bytes.size;
+    return 0;
+}
+
+// Builds the array from `%{values: binary, validity: binary | nil}`, where
+// `values` holds `length` values in Arrow's little-endian layout and
+// `validity` is an Arrow validity bitmap. Both buffers reference the
+// Erlang binaries directly.
+int do_get_packed(ErlNifEnv *env, ERL_NIF_TERM data, int64_t length, bool skip_init, struct AdbcColumnType * column_type, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+    int64_t value_bytes = packed_value_bytes(column_type->arrow_type);
+    if (value_bytes == 0) {
+        snprintf(error_out->message, sizeof(error_out->message), "packed binary data is not supported for columns of arrow type %d, use a list instead", column_type->arrow_type);
+        return kErrorBufferPackedData;
+    }
+    if (skip_init) {
+        snprintf(error_out->message, sizeof(error_out->message), "packed binary data is not supported for list items, use a list instead");
+        return kErrorBufferPackedData;
+    }
+
+    ERL_NIF_TERM values_term, validity_term;
+    ErlNifBinary values, validity;
+    if (!enif_get_map_value(env, data, kAtomValues, &values_term) || !enif_inspect_binary(env, values_term, &values)) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected the `values` of packed `Adbc.Column` data to be a binary.");
+        return kErrorBufferPackedData;
+    }
+    if (!enif_get_map_value(env, data, kAtomValidity, &validity_term)) {
+        validity_term = kAtomNil;
+    }
+    bool has_validity = !enif_is_identical(validity_term, kAtomNil);
+    if (has_validity && !enif_inspect_binary(env, validity_term, &validity)) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected the `validity` of packed `Adbc.Column` data to be a binary or nil.");
+        return kErrorBufferPackedData;
+    }
+
+    if ((int64_t)values.size != length * value_bytes) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected %lld bytes of packed values for %lld values of %lld bytes each, got %zu bytes.", (long long)(length * value_bytes), (long long)length, (long long)value_bytes, values.size);
+        return kErrorBufferPackedData;
+    }
+    if (has_validity && (int64_t)validity.size < (length + 7) / 8) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected at least %lld bytes of validity bitmap for %lld values, got %zu bytes.", (long long)((length + 7) / 8), (long long)length, validity.size);
+        return kErrorBufferPackedData;
+    }
+
+    switch (column_type->arrow_type) {
+        case NANOARROW_TYPE_TIME32:
+        case NANOARROW_TYPE_TIME64:
+        case NANOARROW_TYPE_DURATION:
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, column_type->arrow_type, column_type->time_unit, NULL));
+            break;
+        case NANOARROW_TYPE_TIMESTAMP:
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeDateTime(schema_out, column_type->arrow_type, column_type->time_unit, column_type->timezone.c_str()));
+            break;
+        default:
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_out, column_type->arrow_type));
+            break;
+    }
+
+    nanoarrow::UniqueArray tmp;
+    NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(tmp.get(), schema_out, error_out));
+
+    // empty buffers are left to nanoarrow's default allocator
+    if (values.size > 0) {
+        NANOARROW_RETURN_NOT_OK(wrap_packed_binary(env, values_term, value_bytes, ArrowArrayBuffer(tmp.get(), 1)));
+    }
+
+    int64_t null_count = 0;
+    if (has_validity && length > 0) {
+        struct ArrowBitmap * bitmap = ArrowArrayValidityBitmap(tmp.get());
+        NANOARROW_RETURN_NOT_OK(wrap_packed_binary(env, validity_term, 1, &bitmap->buffer));
+        bitmap->size_bits = length;
+        null_count = length - ArrowBitCountSet(bitmap->buffer.data, 0, length);
+    }
+
+    tmp->length = length;
+    tmp->null_count = null_count;
+    NANOARROW_RETURN_NOT_OK(ArrowArrayFinishBuildingDefault(tmp.get(), error_out));
+    ArrowArrayMove(tmp.get(), array_out);
+    return 0;
+}
+
 // non-zero return value indicates there was no metadata or an error
 int build_metadata_from_nif(ErlNifEnv *env, ERL_NIF_TERM metadata_term, struct ArrowBuffer *metadata_buffer, struct ArrowError* error_out) {
     NANOARROW_RETURN_NOT_OK(ArrowMetadataBuilderInit(metadata_buffer, nullptr));
@@ -1133,6 +1351,36 @@ int must_be_adbc_column(ErlNifEnv *env,
         if (!enif_is_map(env, data_term)) {
             return kErrorBufferDataIsNotAMap;
         }
+    } else if (enif_is_identical(type_term, kAdbcColumnTypeRunEndEncoded)) {
+        // `%{run_ends: column, values: column}`,
+        // the number of logical values is given by the `length` field
+        ERL_NIF_TERM length_term;
+        if (!enif_is_map(env, data_term)) {
+            return kErrorBufferDataIsNotAMap;
+        }
+        if (!enif_get_map_value(env, adbc_column, kAtomLengthKey, &length_term)) {
+            return kErrorBufferGetMapValue;
+        }
+        if (n_items) {
+            if (!enif_get_uint(env, length_term, n_items)) {
+                return kErrorBufferGetDataListLength;
+            }
+        }
+    } else if (enif_is_map(env, data_term)) {
+        // packed data, `%{values: binary, validity: binary | nil}`,
+        // the number of values is given by the `length` field
+        ERL_NIF_TERM values_term, length_term;
+        if (!enif_get_map_value(env, data_term, kAtomValues, &values_term) || !enif_is_binary(env, values_term)) {
+            return kErrorBufferDataIsNotAList;
+        }
+        if (!enif_get_map_value(env, adbc_column, kAtomLengthKey, &length_term)) {
+            return kErrorBufferGetMapValue;
+        }
+        if (n_items) {
+            if (!enif_get_uint(env, length_term, n_items)) {
+                return kErrorBufferGetDataListLength;
+            }
+        }
     } else {
         if (!enif_is_list(env, data_term)) {
             return kErrorBufferDataIsNotAList;
@@ -1193,6 +1441,8 @@ struct AdbcColumnType adbc_column_type_to_nanoarrow_type(ErlNifEnv *env, ERL_NIF
         ret.arrow_type = NANOARROW_TYPE_LARGE_LIST;
     } else if (enif_is_identical(type_term, kAdbcColumnTypeDictionary)) {
         ret.arrow_type = NANOARROW_TYPE_DICTIONARY;
+    } else if (enif_is_identical(type_term, kAdbcColumnTypeRunEndEncoded)) {
+        ret.arrow_type = NANOARROW_TYPE_RUN_END_ENCODED;
     } else if (enif_is_tuple(env, type_term)) {
         if (enif_is_identical(type_term, kAdbcColumnTypeTime32Seconds)) {
             ret.arrow_type = NANOARROW_TYPE_TIME32;
@@ -1357,7 +1607,11 @@ int adbc_column_to_adbc_field(ErlNifEnv *env, struct AdbcColumnNifTerm * column,
 
     int ret = kErrorBufferUnknownType;
     ERL_NIF_TERM data_term = column->data_term;
-    if (column_type.arrow_type == NANOARROW_TYPE_BOOL) {
+    if (column_type.arrow_type != NANOARROW_TYPE_DICTIONARY &&
+        column_type.arrow_type != NANOARROW_TYPE_RUN_END_ENCODED &&
+        enif_is_map(env, data_term)) {
+        return do_get_packed(env, data_term, column->n_items, skip_init, &column_type, array_out, schema_out, error_out);
+    } else if (column_type.arrow_type == NANOARROW_TYPE_BOOL) {
         ret = do_get_list_boolean(env, data_term, nullable, column_type.arrow_type, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_INT8) {
         ret = do_get_list_integer<int8_t>(env, data_term, nullable, skip_init, NANOARROW_TYPE_INT8, array_out, schema_out, error_out);
@@ -1417,6 +1671,8 @@ int adbc_column_to_adbc_field(ErlNifEnv *env, struct AdbcColumnNifTerm * column,
         ret = do_get_list_decimal(env, data_term, nullable, column_type.arrow_type, column_type.bits, column_type.precision, column_type.scale, array_out, schema_out, error_out);
     } else if (column_type.arrow_type == NANOARROW_TYPE_DICTIONARY) {
         ret = do_get_dictionary(env, data_term, nullable, array_out, schema_out, error_out);
+    } else if (column_type.arrow_type == NANOARROW_TYPE_RUN_END_ENCODED) {
+        ret = do_get_run_end_encoded(env, column, array_out, schema_out, error_out);
     }
 
     if (ret == kErrorBufferUnknownType) {
@@ -1516,11 +1772,13 @@ int adbc_column_to_arrow_type_struct(ErlNifEnv *env, ERL_NIF_TERM values, struct
                 snprintf(error_out->message, sizeof(error_out->message), "Expected the `data` field of `Adbc.Column` to be a list of values.");
                 return 1;
             case kErrorBufferDataIsNotAMap:
-                snprintf(error_out->message, sizeof(error_out->message), "Expected the `data` field of dictionary `Adbc.Column` to be a map.");
+                snprintf(error_out->message, sizeof(error_out->message), "Expected the `data` field of dictionary or run-end encoded `Adbc.Column` to be a map.");
                 return 1;
             case kErrorBufferUnknownType:
             case kErrorBufferGetMetadataKey:
             case kErrorBufferGetMetadataValue:
+            case kErrorBufferPackedData:
+            case kErrorBufferRunEndEncoded:
             case kErrorInternalError:
                 // error message is already set
                 return 1;
@@ -0,0 +1,226 @@
+#ifndef ADBC_COLUMN_ROWS_HPP
+#define ADBC_COLUMN_ROWS_HPP
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <erl_nif.h>
+#include <nanoarrow/nanoarrow.h>
+#include "adbc_consts.h"
+#include "adbc_column.hpp"
+#include "nif_utils.hpp"
+
+struct AdbcRowsColumn {
+    // key of the column in map rows
+    ERL_NIF_TERM key;
+    ERL_NIF_TERM name_term;
+    ERL_NIF_TERM type_term;
+    std::string name;
+    struct AdbcColumnType type;
+    // set if values are appended while walking the rows, otherwise
+    // they are collected into `values` and encoded with `adbc_column_to_adbc_field`
+    bool direct;
+    std::vector<ERL_NIF_TERM> values;
+};
+
+static bool adbc_rows_column_is_direct(enum ArrowType type) {
+    switch (type) {
+        case NANOARROW_TYPE_BOOL:
+        case NANOARROW_TYPE_INT8:
+        case NANOARROW_TYPE_UINT8:
+        case NANOARROW_TYPE_INT16:
+        case NANOARROW_TYPE_UINT16:
+        case NANOARROW_TYPE_INT32:
+        case NANOARROW_TYPE_UINT32:
+        case NANOARROW_TYPE_INT64:
+        case NANOARROW_TYPE_UINT64:
+        case NANOARROW_TYPE_FLOAT:
+        case NANOARROW_TYPE_DOUBLE:
+        case NANOARROW_TYPE_BINARY:
+        case NANOARROW_TYPE_LARGE_BINARY:
+        case NANOARROW_TYPE_STRING:
+        case NANOARROW_TYPE_LARGE_STRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// same conversions as `get_list_integer`, `get_list_float`,
+// `get_list_string` and `get_list_boolean` with nullable columns
+// @return 0 if appended, 1 if `value` does not match the column type,
+// or a nanoarrow error code
+static int adbc_rows_column_append(ErlNifEnv *env, struct AdbcRowsColumn &column, struct ArrowArray * array, ERL_NIF_TERM value) {
+    if (enif_is_identical(value, kAtomNil)) {
+        return ArrowArrayAppendNull(array, 1);
+    }
+
+    switch (column.type.arrow_type) {
+        case NANOARROW_TYPE_BOOL:
+            if (enif_is_identical(value, kAtomTrue)) return ArrowArrayAppendInt(array, 1);
+            if (enif_is_identical(value, kAtomFalse)) return ArrowArrayAppendInt(array, 0);
+            return 1;
+        case NANOARROW_TYPE_UINT8:
+        case NANOARROW_TYPE_UINT16:
+        case NANOARROW_TYPE_UINT32:
+        case NANOARROW_TYPE_UINT64: {
+            uint64_t val;
+            if (!erlang::nif::get(env, value, &val)) return 1;
+            return ArrowArrayAppendUInt(array, val);
+        }
+        case NANOARROW_TYPE_INT8:
+        case NANOARROW_TYPE_INT16:
+        case NANOARROW_TYPE_INT32:
+        case NANOARROW_TYPE_INT64: {
+            int64_t val;
+            if (!erlang::nif::get(env, value, &val)) return 1;
+            return ArrowArrayAppendInt(array, val);
+        }
+        case NANOARROW_TYPE_FLOAT:
+        case NANOARROW_TYPE_DOUBLE: {
+            double val;
+            int64_t integer;
+            if (erlang::nif::get(env, value, &val)) {
+                return ArrowArrayAppendDouble(array, val);
+            } else if (erlang::nif::get(env, value, &integer)) {
+                // rows built from maps often have integers in float columns
+                return ArrowArrayAppendDouble(array, static_cast<double>(integer));
+            } else if (enif_is_identical(value, kAtomInfinity)) {
+                return ArrowArrayAppendDouble(array, std::numeric_limits<double>::infinity());
+            } else if (enif_is_identical(value, kAtomNegInfinity)) {
+                return ArrowArrayAppendDouble(array, -std::numeric_limits<double>::infinity());
+            } else if (enif_is_identical(value, kAtomNaN)) {
+                return ArrowArrayAppendDouble(array, std::numeric_limits<double>::quiet_NaN());
+            }
+            return 1;
+        }
+        default: {
+            ErlNifBinary bytes;
+            if (!enif_inspect_iolist_as_binary(env, value, &bytes)) return 1;
+            struct ArrowBufferView view{};
+            view.data.data = bytes.data;
+            view.size_bytes = static_cast<int64_t>(bytes.size);
+            return ArrowArrayAppendBytes(array, view);
+        }
+    }
+}
+
+// Transposes `rows`, a list of maps or tuples, into a struct array with one
+// child per column in `fields`, a list of `{key, name, type}`. Values of map
+// rows are looked up by `key` (missing keys are nil), while tuple rows
+// have one value per column, in order.
+//
+// The rows are walked once: columns of primitive types are appended into
+// builders reserved for all rows, the values of the other columns are
+// collected and encoded as the `data` of an `%Adbc.Column{}` would be.
+//
+// non-zero return value indicating errors
+int adbc_rows_to_arrow_type_struct(ErlNifEnv *env, ERL_NIF_TERM rows, ERL_NIF_TERM fields, struct ArrowArray* array_out, struct ArrowSchema* schema_out, struct ArrowError* error_out) {
+    unsigned n_rows = 0, n_columns = 0;
+    if (!enif_get_list_length(env, rows, &n_rows) || !enif_get_list_length(env, fields, &n_columns)) {
+        snprintf(error_out->message, sizeof(error_out->message), "Expected rows and columns to be lists.");
+        return 1;
+    }
+
+    std::vector<struct AdbcRowsColumn> columns(n_columns);
+    ERL_NIF_TERM head, tail = fields;
+    for (unsigned i = 0; enif_get_list_cell(env, tail, &head, &tail); i++) {
+        auto &column = columns[i];
+        int arity = 0;
+        const ERL_NIF_TERM * field = nullptr;
+        if (!enif_get_tuple(env, head, &arity, &field) || arity != 3 || !erlang::nif::get(env, field[1], column.name)) {
+            enif_snprintf(error_out->message, sizeof(error_out->message), "Expected column to be a `{key, name, type}` tuple, got: `%T`.", head);
+            return 1;
+        }
+        column.key = field[0];
+        column.name_term = field[1];
+        column.type_term = field[2];
+        column.type = adbc_column_type_to_nanoarrow_type(env, column.type_term);
+        if (column.type.valid == 0) {
+            enif_snprintf(error_out->message, sizeof(error_out->message), "unsupport type `%T` for column `%s`.", column.type_term, column.name.c_str());
+            return 1;
+        }
+        column.direct = adbc_rows_column_is_direct(column.type.arrow_type);
+        if (!column.direct) {
+            column.values.reserve(n_rows);
+        }
+    }
+
+    ArrowSchemaInit(schema_out);
+    NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(schema_out, n_columns));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromType(array_out, NANOARROW_TYPE_STRUCT));
+    NANOARROW_RETURN_NOT_OK(ArrowArrayAllocateChildren(array_out, static_cast<int64_t>(n_columns)));
+
+    for (unsigned i = 0; i < n_columns; i++) {
+        if (!columns[i].direct) continue;
+        auto schema_i = schema_out->children[i];
+        auto child_i = array_out->children[i];
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(schema_i, columns[i].type.arrow_type));
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(schema_i, columns[i].name.c_str()));
+        NANOARROW_RETURN_NOT_OK(ArrowArrayInitFromSchema(child_i, schema_i, error_out));
+        NANOARROW_RETURN_NOT_OK(ArrowArrayStartAppending(child_i));
+        NANOARROW_RETURN_NOT_OK(ArrowArrayReserve(child_i, n_rows));
+    }
+
+    tail = rows;
+    while (enif_get_list_cell(env, tail, &head, &tail)) {
+        int arity = 0;
+        const ERL_NIF_TERM * elements = nullptr;
+        bool is_map = enif_is_map(env, head);
+        if (!is_map && (!enif_get_tuple(env, head, &arity, &elements) || arity != (int)n_columns)) {
+            enif_snprintf(error_out->message, sizeof(error_out->message), "Expected rows to be maps or tuples of %u elements, got: `%T`.", n_columns, head);
+            return 1;
+        }
+
+        for (unsigned i = 0; i < n_columns; i++) {
+            auto &column = columns[i];
+            ERL_NIF_TERM value = kAtomNil;
+            if (!is_map) {
+                value = elements[i];
+            } else if (!enif_get_map_value(env, head, column.key, &value)) {
+                value = kAtomNil;
+            }
+
+            if (!column.direct) {
+                column.values.push_back(value);
+                continue;
+            }
+
+            int ret = adbc_rows_column_append(env, column, array_out->children[i], value);
+            if (ret != 0) {
+                // nanoarrow errors for values out of the range of the type
+                enif_snprintf(error_out->message, sizeof(error_out->message), "Expected values of column `%s` to be of type `%T`, got: `%T`.", column.name.c_str(), column.type_term, value);
+                return 1;
+            }
+        }
+    }
+
+    for (unsigned i = 0; i < n_columns; i++) {
+        auto &column = columns[i];
+        if (column.direct) continue;
+
+        struct AdbcColumnNifTerm column_term{};
+        column_term.is_nil = 0;
+        column_term.n_items = n_rows;
+        column_term.name_term = column.name_term;
+        column_term.type_term = column.type_term;
+        column_term.nullable_term = kAtomTrue;
+        column_term.metadata_term = kAtomNil;
+        column_term.data_term = enif_make_list_from_array(env, column.values.data(), n_rows);
+
+        int ret = adbc_column_to_adbc_field(env, &column_term, false, false, array_out->children[i], schema_out->children[i], error_out);
+        if (ret != 0) {
+            if (error_out->message[0] == '\0') {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "Invalid values for column `%s` of type `%T`.", column.name.c_str(), column.type_term);
+            }
+            return 1;
+        }
+    }
+
+    array_out->length = n_rows;
+    return ArrowArrayFinishBuildingDefault(array_out, error_out);
+}
+
+#endif  // ADBC_COLUMN_ROWS_HPP
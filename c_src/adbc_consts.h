@@ -18,6 +18,16 @@ static ERL_NIF_TERM kAtomNegInfinity;
 static ERL_NIF_TERM kAtomNaN;
 static ERL_NIF_TERM kAtomEndOfSeries;
 static ERL_NIF_TERM kAtomStructKey;
+static ERL_NIF_TERM kAtomZeroCopy;
+static ERL_NIF_TERM kAtomWorkers;
+static ERL_NIF_TERM kAtomDecodeDictionary;
+static ERL_NIF_TERM kAtomColumns;
+static ERL_NIF_TERM kAtomDecode;
+static ERL_NIF_TERM kAtomPacked;
+static ERL_NIF_TERM kAtomPlainLists;
+static ERL_NIF_TERM kAtomClosed;
+static ERL_NIF_TERM kAtomFull;
+static ERL_NIF_TERM kAtomReady;
 // for the data field in list views and large list views
 // %Adbc.Column{
 //   name: "sample_list_view",
@@ -74,6 +84,11 @@ static ERL_NIF_TERM kAtomMinuteKey;
 static ERL_NIF_TERM kAtomSecondKey;
 static ERL_NIF_TERM kAtomMicrosecondKey;
 
+static ERL_NIF_TERM kAtomDecimalModule;
+static ERL_NIF_TERM kAtomSignKey;
+static ERL_NIF_TERM kAtomCoefKey;
+static ERL_NIF_TERM kAtomExpKey;
+
 static ERL_NIF_TERM kAtomAdbcColumnModule;
 static ERL_NIF_TERM kAtomNameKey;
 static ERL_NIF_TERM kAtomTypeKey;
@@ -139,5 +154,7 @@ constexpr int kErrorBufferGetMetadataKey = 8;
 constexpr int kErrorBufferGetMetadataValue = 9;
 constexpr int kErrorExpectedCalendarISO = 10;
 constexpr int kErrorInternalError = 11;
+constexpr int kErrorBufferPackedData = 12;
+constexpr int kErrorBufferRunEndEncoded = 13;
 
 #endif  // ADBC_CONSTS_H
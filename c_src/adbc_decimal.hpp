@@ -0,0 +1,65 @@
+#ifndef ADBC_DECIMAL_HPP
+#define ADBC_DECIMAL_HPP
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <erl_nif.h>
+
+// Conversions of the two's complement integers of Arrow's decimal128 and
+// decimal256 values into the coefficient of a `Decimal`.
+//
+// The values are handled as little-endian 64-bit limbs so that both widths
+// share the same code and it does not depend on a 128-bit integer type,
+// which MSVC does not provide.
+
+constexpr int kDecimalMaxLimbs = 4;
+
+/// Reads the `nlimbs` limbs of the value at `val` and replaces them with
+/// the limbs of its absolute value.
+/// @return true if the value is negative
+static inline bool decimal_abs_limbs(const uint8_t * val, int nlimbs, uint64_t * limbs) {
+    memcpy(limbs, val, sizeof(uint64_t) * nlimbs);
+    bool negative = (limbs[nlimbs - 1] >> 63) != 0;
+    if (negative) {
+        uint64_t carry = 1;
+        for (int i = 0; i < nlimbs; i++) {
+            limbs[i] = ~limbs[i] + carry;
+            carry = (carry && limbs[i] == 0) ? 1 : 0;
+        }
+    }
+    return negative;
+}
+
+/// Makes a non-negative integer out of `nlimbs` little-endian limbs.
+///
+/// Values that fit in 64 bits are made directly; larger ones are decoded
+/// from the external term format (`SMALL_BIG_EXT`), since the NIF API has
+/// no other way of creating a bignum.
+/// @return false if the bignum could not be decoded
+static inline bool decimal_make_coefficient(ErlNifEnv * env, const uint64_t * limbs, int nlimbs, ERL_NIF_TERM &coefficient) {
+    int used = nlimbs;
+    while (used > 1 && limbs[used - 1] == 0) used--;
+    if (used == 1) {
+        coefficient = enif_make_uint64(env, limbs[0]);
+        return true;
+    }
+
+    // version, tag, number of digits, sign and up to 32 digits
+    unsigned char ext[4 + sizeof(uint64_t) * kDecimalMaxLimbs];
+    size_t ndigits = 0;
+    for (int i = 0; i < used; i++) {
+        for (int b = 0; b < 8; b++) {
+            ext[4 + ndigits++] = (unsigned char)(limbs[i] >> (8 * b));
+        }
+    }
+    while (ext[4 + ndigits - 1] == 0) ndigits--;
+    ext[0] = 131;
+    ext[1] = 110;
+    ext[2] = (unsigned char)ndigits;
+    ext[3] = 0;
+
+    return enif_binary_to_term(env, ext, 4 + ndigits, &coefficient, 0) != 0;
+}
+
+#endif  // ADBC_DECIMAL_HPP
@@ -1,6 +1,8 @@
 #include <cstdbool>
 #include <cstdio>
 #include <climits>
+#include <algorithm>
+#include <atomic>
 #include <arrow-adbc/adbc.h>
 #include <erl_nif.h>
 #include <nanoarrow/nanoarrow.h>
@@ -8,8 +10,12 @@
 #include "nif_utils.hpp"
 #include "adbc_consts.h"
 #include "adbc_column.hpp"
+#include "adbc_column_rows.hpp"
 #include "adbc_arrow_schema.hpp"
 #include "adbc_arrow_array.hpp"
+#include "adbc_arrow_buffer.hpp"
+#include "adbc_arrow_concat.hpp"
+#include "adbc_thread_pool.hpp"
 
 template<> ErlNifResourceType * NifRes<struct AdbcDatabase>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct AdbcConnection>::type = nullptr;
@@ -17,6 +23,7 @@ template<> ErlNifResourceType * NifRes<struct AdbcStatement>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct AdbcError>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct ArrowArrayStream>::type = nullptr;
 template<> ErlNifResourceType * NifRes<struct ArrowArrayStreamRecord>::type = nullptr;
+template<> ErlNifResourceType * NifRes<struct ArrowArrayStreamQueueProducer>::type = nullptr;
 
 static ERL_NIF_TERM nif_error_from_adbc_error(ErlNifEnv *env, struct AdbcError * adbc_error) {
     char const* message = (adbc_error->message == nullptr) ? "unknown error" : adbc_error->message;
@@ -34,6 +41,71 @@ static ERL_NIF_TERM nif_error_from_adbc_error(ErlNifEnv *env, struct AdbcError *
     return nif_error;
 }
 
+// Native thread pools, started on first use with the size given by their
+// first caller, and stopped when the library is unloaded
+static ErlNifMutex * thread_pools_mutex = nullptr;
+// decodes columns for `adbc_columns_materialize`
+static AdbcThreadPool * materialize_pool = nullptr;
+// runs the `*_async` queries into the driver
+static AdbcThreadPool * executor_pool = nullptr;
+// runs `adbc_connection_init_async`, so that opening a connection does not
+// wait for the queries running on the executor pool
+static AdbcThreadPool * setup_pool = nullptr;
+// deletes the stream prefetchers detached from their stream
+static AdbcThreadPool * cleanup_pool = nullptr;
+
+static AdbcThreadPool * get_thread_pool(AdbcThreadPool ** pool_ref, const char * name, int n_workers) {
+    enif_mutex_lock(thread_pools_mutex);
+    if (*pool_ref == nullptr) {
+        auto pool = new AdbcThreadPool();
+        if (pool->start(name, n_workers) == 0) {
+            *pool_ref = pool;
+        } else {
+            delete pool;
+        }
+    }
+    enif_mutex_unlock(thread_pools_mutex);
+    return *pool_ref;
+}
+
+static AdbcThreadPool * get_cleanup_pool() {
+    return get_thread_pool(&cleanup_pool, "adbc_cleanup", 1);
+}
+
+// Runs `job` on the executor pool, which sends `{ref, job_result}` to the
+// calling process once done. `job` builds its result in the given env.
+static ERL_NIF_TERM submit_async(ErlNifEnv *env, AdbcThreadPool * pool, ERL_NIF_TERM ref, std::function<ERL_NIF_TERM(ErlNifEnv *)> job) {
+    ErlNifPid pid;
+    ErlNifEnv * msg_env = nullptr;
+    if (enif_self(env, &pid) == nullptr || (msg_env = enif_alloc_env()) == nullptr) {
+        return erlang::nif::error(env, "cannot run the call asynchronously");
+    }
+
+    ERL_NIF_TERM msg_ref = enif_make_copy(msg_env, ref);
+    pool->submit([pid, msg_env, msg_ref, job = std::move(job)]() mutable {
+        ERL_NIF_TERM result = job(msg_env);
+        enif_send(nullptr, &pid, msg_env, enif_make_tuple2(msg_env, msg_ref, result));
+        enif_free_env(msg_env);
+    });
+    return erlang::nif::ok(env);
+}
+
+// Reads the `ref` and `workers` arguments of the `*_async` NIFs and gets
+// the pool at `pool_ref`, started with `workers` threads on first use
+// @return nullptr if the arguments are invalid or the pool cannot be started
+static AdbcThreadPool * get_async_pool(ErlNifEnv *env, AdbcThreadPool ** pool_ref, const char * name, ERL_NIF_TERM ref, ERL_NIF_TERM workers, ERL_NIF_TERM &error) {
+    int n_workers;
+    if (!enif_is_ref(env, ref) || !enif_get_int(env, workers, &n_workers) || n_workers <= 0) {
+        error = enif_make_badarg(env);
+        return nullptr;
+    }
+    AdbcThreadPool * pool = get_thread_pool(pool_ref, name, n_workers);
+    if (pool == nullptr) {
+        error = erlang::nif::error(env, "cannot start the native executor threads");
+    }
+    return pool;
+}
+
 static ERL_NIF_TERM adbc_database_new(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcDatabase>;
 
@@ -272,6 +344,18 @@ static ERL_NIF_TERM adbc_connection_set_option(ErlNifEnv *env, int argc, const E
     );
 }
 
+static ERL_NIF_TERM connection_init(ErlNifEnv *env, NifRes<struct AdbcConnection> * connection, NifRes<struct AdbcDatabase> * db) {
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = AdbcConnectionInit(&connection->val, &db->val, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+
+    connection->private_data = &db->val;
+    enif_keep_resource(&db->val);
+    return erlang::nif::ok(env);
+}
+
 static ERL_NIF_TERM adbc_connection_init(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcConnection>;
     using db_type = NifRes<struct AdbcDatabase>;
@@ -286,15 +370,36 @@ static ERL_NIF_TERM adbc_connection_init(ErlNifEnv *env, int argc, const ERL_NIF
         return error;
     }
 
-    struct AdbcError adbc_error{};
-    AdbcStatusCode code = AdbcConnectionInit(&connection->val, &db->val, &adbc_error);
-    if (code != ADBC_STATUS_OK) {
-        return nif_error_from_adbc_error(env, &adbc_error);
+    return connection_init(env, connection, db);
+}
+
+static ERL_NIF_TERM adbc_connection_init_async(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcConnection>;
+    using db_type = NifRes<struct AdbcDatabase>;
+
+    ERL_NIF_TERM error{};
+    res_type * connection = nullptr;
+    db_type * db = nullptr;
+    AdbcThreadPool * pool = nullptr;
+    if ((connection = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+    if ((db = db_type::get_resource(env, argv[1], error)) == nullptr) {
+        return error;
+    }
+    if ((pool = get_async_pool(env, &setup_pool, "adbc_setup", argv[2], argv[3], error)) == nullptr) {
+        return error;
     }
 
-    connection->private_data = &db->val;
-    enif_keep_resource(&db->val);
-    return erlang::nif::ok(env);
+    // keep both alive until the job is done
+    enif_keep_resource(connection);
+    enif_keep_resource(db);
+    return submit_async(env, pool, argv[2], [connection, db](ErlNifEnv * msg_env) {
+        ERL_NIF_TERM ret = connection_init(msg_env, connection, db);
+        enif_release_resource(db);
+        enif_release_resource(connection);
+        return ret;
+    });
 }
 
 static ERL_NIF_TERM adbc_connection_get_info(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
@@ -438,6 +543,25 @@ static ERL_NIF_TERM adbc_connection_get_objects(ErlNifEnv *env, int argc, const
     return enif_make_tuple2(env, erlang::nif::ok(env), ret);
 }
 
+// Cancels the operation running on the connection (e.g. get_info or reading
+// its stream), safe to call while that operation runs on another thread
+static ERL_NIF_TERM adbc_connection_cancel(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcConnection>;
+
+    ERL_NIF_TERM error{};
+    res_type * connection = nullptr;
+    if ((connection = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = AdbcConnectionCancel(&connection->val, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+    return erlang::nif::ok(env);
+}
+
 static ERL_NIF_TERM adbc_connection_get_table_types(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcConnection>;
     using array_stream_type = NifRes<struct ArrowArrayStream>;
@@ -476,14 +600,85 @@ static ERL_NIF_TERM adbc_arrow_array_stream_get_pointer(ErlNifEnv *env, int argc
     return enif_make_uint64(env, reinterpret_cast<uint64_t>(&res->val));
 }
 
+// Returns the per-stream data of `res`, allocating it on the first call
+// @return nullptr with `error` set if failed
+static struct ArrowArrayStreamPrivateData * get_arrow_array_stream_private_data(ErlNifEnv *env, NifRes<struct ArrowArrayStream> * res, ERL_NIF_TERM &error) {
+    // only allocate priv data once for the entire stream
+    if (res->private_data != nullptr) {
+        return (struct ArrowArrayStreamPrivateData *)res->private_data;
+    }
+
+    int code = 0;
+    const char * reason = nullptr;
+    auto private_data = (struct ArrowArrayStreamPrivateData *)enif_alloc(sizeof(struct ArrowArrayStreamPrivateData));
+    if (private_data != nullptr) {
+        memset(private_data, 0, sizeof(struct ArrowArrayStreamPrivateData));
+        struct ArrowSchema schema{};
+        code = res->val.get_schema(&res->val, &schema);
+        if (code != 0) {
+            reason = res->val.get_last_error(&res->val);
+        } else {
+            // parse the schema once, every batch of this stream shares the same plan
+            private_data->plan = new_shared_arrow_stream_plan(&schema);
+            private_data->columns_env = enif_alloc_env();
+            if (private_data->plan == nullptr || private_data->columns_env == nullptr) {
+                code = 1;
+                reason = "out of memory";
+                if (schema.release) {
+                    schema.release(&schema);
+                }
+            } else if (arrow_schema_to_column_terms(private_data->columns_env, &private_data->plan->schema, private_data->columns, error) != 0) {
+                code = 1;
+                error = enif_make_copy(env, error);
+            }
+        }
+
+        if (code != 0) {
+            release_shared_arrow_decoder_plan(private_data->plan);
+            if (private_data->columns_env) {
+                enif_free_env(private_data->columns_env);
+            }
+            enif_free(private_data);
+            private_data = nullptr;
+        }
+    } else {
+        reason = "out of memory";
+    }
+    res->private_data = private_data;
+
+    if (res->private_data == nullptr && (reason != nullptr || error == 0)) {
+        error = erlang::nif::error(env, reason ? reason : "unknown error");
+    }
+    return private_data;
+}
+
+// Gets the next batch of the stream, from the prefetcher if there is one
+// @return the same as `get_next`, with `reason` set if failed
+static int arrow_array_stream_get_next(NifRes<struct ArrowArrayStream> * res, struct ArrowArray * array, std::string &reason) {
+    auto private_data = (struct ArrowArrayStreamPrivateData *)res->private_data;
+    if (private_data != nullptr && private_data->prefetcher != nullptr) {
+        return private_data->prefetcher->next(array, reason);
+    }
+
+    if (res->val.release == nullptr) {
+        reason = "the stream has already been released";
+        return EINVAL;
+    }
+    int code = res->val.get_next(&res->val, array);
+    if (code != 0) {
+        const char * last_error = res->val.get_last_error(&res->val);
+        reason = last_error ? last_error : "unknown error: cannot get next record with record->val.values";
+    }
+    return code;
+}
+
 static ERL_NIF_TERM adbc_arrow_array_stream_next(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct ArrowArrayStream>;
     ERL_NIF_TERM error{};
 
     res_type * res = nullptr;
-    struct ArrowSchema * schema = nullptr;
+    struct ArrowArrayStreamPrivateData * private_data = nullptr;
     struct ArrowArray array{};
-    std::vector<ERL_NIF_TERM> out_terms;
 
     if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
         return error;
@@ -492,44 +687,26 @@ static ERL_NIF_TERM adbc_arrow_array_stream_next(ErlNifEnv *env, int argc, const
         return enif_make_badarg(env);
     }
 
-    int code = res->val.get_next(&res->val, &array);
+    std::string reason;
+    int code = arrow_array_stream_get_next(res, &array, reason);
     if (code != 0) {
-        const char * reason = res->val.get_last_error(&res->val);
-        return erlang::nif::error(env, reason ? reason : "unknown error: cannot get next record with record->val.values");
+        return erlang::nif::error(env, reason.c_str());
     }
     // if no error and the array is released, the stream has ended
     if (array.release == nullptr) {
         return kAtomEndOfSeries;
     }
 
-    // only allocate priv data once for the entire stream
-    if (res->private_data == nullptr) {
-        const char * reason = nullptr;
-        res->private_data = enif_alloc(sizeof(struct ArrowSchema));
-        if (res->private_data != nullptr) {
-            memset(res->private_data, 0, sizeof(struct ArrowSchema));
-            code = res->val.get_schema(&res->val, (struct ArrowSchema *)res->private_data);
-        } else {
-            reason = "out of memory";
-        }
-
-        // if `res->private_data` was null, `code` will still be 0
-        if (code != 0) {
-            reason = res->val.get_last_error(&res->val);
-            enif_free(res->private_data);
-            res->private_data = nullptr;
-        }
-
-        if (res->private_data == nullptr) {
-            error = erlang::nif::error(env, reason ? reason : "unknown error");
-            if (array.release) {
-                array.release(&array);
-            }
-            return error;
-        }
+    if ((private_data = get_arrow_array_stream_private_data(env, res, error)) == nullptr) {
+        array.release(&array);
+        return error;
     }
-    schema = (struct ArrowSchema *)res->private_data;
-    code = arrow_schema_to_nif_term(env, schema, &array, out_terms, error);
+
+    // the schema-derived terms are built once per stream, only the data
+    // references are new for each batch
+    ERL_NIF_TERM columns = enif_make_copy(env, private_data->columns);
+    ERL_NIF_TERM out{};
+    code = arrow_array_to_column_terms(env, private_data->plan, columns, &array, out, error);
     // the outter array should be released because we have moved the values
     // for each column to the corresponding reference in `Adbc.Column.data`
     if (array.release) {
@@ -537,74 +714,155 @@ static ERL_NIF_TERM adbc_arrow_array_stream_next(ErlNifEnv *env, int argc, const
     }
 
     if (code != 0) {
-        // error is already set in arrow_schema_to_nif_term
-        // we don't need to release the schema in private data here
-        // it will be released when the stream resource is GC'd
+        // error is already set in arrow_array_to_column_terms
         return error;
     } else {
-        return erlang::nif::ok(env, out_terms[0]);
+        return erlang::nif::ok(env, out);
     }
 }
 
-static ERL_NIF_TERM adbc_column_materialize(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+// Reads an optional positive limit, `nil` means no limit
+static bool get_optional_limit(ErlNifEnv *env, ERL_NIF_TERM term, int64_t &limit) {
+    if (enif_is_identical(term, kAtomNil)) {
+        limit = -1;
+        return true;
+    }
+    ErlNifSInt64 value;
+    if (!enif_get_int64(env, term, &value) || value <= 0) {
+        return false;
+    }
+    limit = (int64_t)value;
+    return true;
+}
+
+// Drains batches from the stream until it ends or until `max_rows` rows or
+// `max_bytes` bytes have been read (the batch crossing the limit is kept),
+// and concatenates the batches of every column into a single array.
+//
+// Columns whose type cannot be concatenated (dictionaries, unions, run-end
+// encoded and list views) keep one reference per batch.
+static ERL_NIF_TERM adbc_arrow_array_stream_collect(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct ArrowArrayStream>;
     using record_type = NifRes<struct ArrowArrayStreamRecord>;
-    record_type * res = nullptr;
+    ERL_NIF_TERM error{};
 
-    std::vector<ERL_NIF_TERM> data_ref;
-    if (enif_is_ref(env, argv[0])) {
-        data_ref.emplace_back(argv[0]);
-    } else if (enif_is_list(env, argv[0])) {
-        unsigned int length;
-        ERL_NIF_TERM list = argv[0];
-        if (!enif_get_list_length(env, list, &length)) {
-            return enif_make_badarg(env);
-        }
+    res_type * res = nullptr;
+    if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+    int64_t max_rows, max_bytes;
+    if (res->val.get_next == nullptr || !get_optional_limit(env, argv[1], max_rows) || !get_optional_limit(env, argv[2], max_bytes)) {
+        return enif_make_badarg(env);
+    }
 
-        ERL_NIF_TERM head, tail;
-        while (enif_get_list_cell(env, list, &head, &tail)) {
-            if (!enif_is_ref(env, head)) {
-                return enif_make_badarg(env);
+    struct ArrowArrayStreamPrivateData * private_data = nullptr;
+    std::vector<struct ArrowArray> batches;
+    auto release_batches = [&batches]() {
+        for (auto &batch : batches) {
+            if (batch.release) {
+                batch.release(&batch);
             }
-            data_ref.emplace_back(head);
-            list = tail;
         }
-    } else {
-        return enif_make_badarg(env);
-    }
+    };
 
-    std::vector<ERL_NIF_TERM> materialized;
-    ERL_NIF_TERM error{};
-    for (auto& ref : data_ref) {
-        if ((res = record_type::get_resource(env, ref, error)) == nullptr) {
-            return error;
+    int64_t rows = 0;
+    int64_t bytes = 0;
+    while ((max_rows < 0 || rows < max_rows) && (max_bytes < 0 || bytes < max_bytes)) {
+        struct ArrowArray array{};
+        std::string reason;
+        if (arrow_array_stream_get_next(res, &array, reason) != 0) {
+            release_batches();
+            return erlang::nif::error(env, reason.c_str());
         }
-        if (res->val.schema == nullptr || res->val.values == nullptr) {
-            return enif_make_badarg(env);
+        if (array.release == nullptr) {
+            break;
         }
+        batches.emplace_back(array);
 
-        std::vector<ERL_NIF_TERM> out_terms;
-        constexpr int level = 0;
-        ERL_NIF_TERM out_type;
-        ERL_NIF_TERM out_metadata;
-        if (arrow_array_to_nif_term(env, res->val.schema, res->val.values, level, out_terms, out_type, out_metadata, error) != 0) {
+        if (private_data == nullptr && (private_data = get_arrow_array_stream_private_data(env, res, error)) == nullptr) {
+            release_batches();
             return error;
         }
+        if (array.n_children != private_data->plan->schema.n_children || (array.n_children > 0 && array.children == nullptr)) {
+            release_batches();
+            return erlang::nif::error(env, "invalid ArrowArray, its children do not match the ArrowSchema of the stream");
+        }
+
+        rows += array.length;
+        if (max_bytes >= 0) {
+            auto &plan = private_data->plan->root;
+            for (int64_t child_i = 0; child_i < array.n_children && child_i < (int64_t)plan.children.size(); child_i++) {
+                const struct ArrowArray * child = array.children[child_i];
+                bytes += arrow_array_slice_bytes(plan.children[child_i], {child, child->offset, child->length});
+            }
+        }
+    }
+
+    if (batches.empty()) {
+        return kAtomEndOfSeries;
+    }
+
+    SharedArrowDecoderPlan * plan = private_data->plan;
+    ERL_NIF_TERM columns = enif_make_copy(env, private_data->columns);
+    std::vector<ERL_NIF_TERM> out;
+    out.reserve(plan->schema.n_children);
+    std::vector<const struct ArrowArray *> parts(batches.size());
+    std::vector<ERL_NIF_TERM> data_refs;
+    ERL_NIF_TERM column;
+    for (int64_t child_i = 0; enif_get_list_cell(env, columns, &column, &columns); child_i++) {
+        struct ArrowSchema * schema = plan->schema.children[child_i];
+        const ArrowDecoderPlan &child_plan = plan->root.children[child_i];
+        for (size_t batch_i = 0; batch_i < batches.size(); batch_i++) {
+            parts[batch_i] = batches[batch_i].children[child_i];
+        }
+
+        data_refs.clear();
+        auto record = record_type::allocate_resource(env, error);
+        if (record == nullptr || record->val.allocate_values_with_stream_schema(plan, child_i)) {
+            release_batches();
+            return record == nullptr ? error : erlang::nif::error(env, "out of memory");
+        }
 
-        ERL_NIF_TERM ret{};
-        if (out_terms.size() == 1) {
-            ret = out_terms[0];
+        if (batches.size() == 1) {
+            ArrowArrayMove(batches[0].children[child_i], record->val.values);
+            data_refs.emplace_back(record->make_resource(env));
+        } else if (is_arrow_array_concatenable(schema, child_plan) && concat_arrow_arrays(schema, child_plan, parts, record->val.values) == 0) {
+            data_refs.emplace_back(record->make_resource(env));
+            // the batches of this column are no longer needed
+            for (auto &batch : batches) {
+                batch.children[child_i]->release(batch.children[child_i]);
+            }
         } else {
-            ret = out_terms[1];
+            // keep one reference per batch, the record allocated above takes the first one
+            for (size_t batch_i = 0; batch_i < batches.size(); batch_i++) {
+                if (batch_i > 0) {
+                    record = record_type::allocate_resource(env, error);
+                    if (record == nullptr || record->val.allocate_values_with_stream_schema(plan, child_i)) {
+                        release_batches();
+                        return record == nullptr ? error : erlang::nif::error(env, "out of memory");
+                    }
+                }
+                ArrowArrayMove(batches[batch_i].children[child_i], record->val.values);
+                data_refs.emplace_back(record->make_resource(env));
+            }
         }
 
-        materialized.emplace_back(ret);
+        ERL_NIF_TERM data = enif_make_list_from_array(env, data_refs.data(), (unsigned)data_refs.size());
+        ERL_NIF_TERM updated;
+        if (!enif_make_map_update(env, column, kAtomDataKey, data, &updated)) {
+            release_batches();
+            return erlang::nif::error(env, "invalid column term");
+        }
+        out.emplace_back(updated);
     }
+    release_batches();
 
-    ERL_NIF_TERM ret = enif_make_list_from_array(env, materialized.data(), materialized.size());
-    return erlang::nif::ok(env, ret);
+    return erlang::nif::ok(env, enif_make_list_from_array(env, out.data(), (unsigned)out.size()));
 }
 
-static ERL_NIF_TERM adbc_arrow_array_stream_release(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+// Starts a native thread that reads up to `depth` batches ahead of
+// `adbc_arrow_array_stream_next` and `adbc_arrow_array_stream_collect`
+static ERL_NIF_TERM adbc_arrow_array_stream_prefetch(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct ArrowArrayStream>;
     ERL_NIF_TERM error{};
 
@@ -612,106 +870,998 @@ static ERL_NIF_TERM adbc_arrow_array_stream_release(ErlNifEnv *env, int argc, co
     if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
         return error;
     }
+    unsigned depth;
+    if (res->val.get_next == nullptr || !enif_get_uint(env, argv[1], &depth) || depth == 0) {
+        return enif_make_badarg(env);
+    }
 
-    if (res->val.release) {
-        res->val.release(&res->val);
-        res->val.release = nullptr;
+    // the stream is moved into the prefetcher once started
+    auto private_data = (struct ArrowArrayStreamPrivateData *)res->private_data;
+    if (private_data != nullptr && private_data->prefetcher != nullptr) {
+        return erlang::nif::ok(env);
+    }
+    if (res->val.release == nullptr) {
+        return erlang::nif::error(env, "the stream has already been released");
+    }
+
+    // the schema is read here, only the reader thread calls into the stream afterwards
+    if ((private_data = get_arrow_array_stream_private_data(env, res, error)) == nullptr) {
+        return error;
     }
 
+    auto prefetcher = new (std::nothrow) ArrowArrayStreamPrefetcher();
+    if (prefetcher == nullptr) {
+        return erlang::nif::error(env, "out of memory");
+    }
+    if (prefetcher->start(&res->val, depth) != 0) {
+        delete prefetcher;
+        return erlang::nif::error(env, "cannot start the prefetch thread");
+    }
+    private_data->prefetcher = prefetcher;
     return erlang::nif::ok(env);
 }
 
-static ERL_NIF_TERM adbc_statement_new(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
-    using res_type = NifRes<struct AdbcStatement>;
-    using connection_type = NifRes<struct AdbcConnection>;
-
-    ERL_NIF_TERM error{};
+// Reads the data of an unmaterialized column, either a single
+// record reference or a list of them (one per batch)
+static bool get_column_data_refs(ErlNifEnv *env, ERL_NIF_TERM term, std::vector<ERL_NIF_TERM> &data_ref) {
+    if (enif_is_ref(env, term)) {
+        data_ref.emplace_back(term);
+    } else if (enif_is_list(env, term)) {
+        unsigned int length;
+        ERL_NIF_TERM list = term;
+        if (!enif_get_list_length(env, list, &length)) {
+            return false;
+        }
 
-    connection_type * connection = nullptr;
-    if ((connection = connection_type::get_resource(env, argv[0], error)) == nullptr) {
-        return error;
+        ERL_NIF_TERM head, tail;
+        while (enif_get_list_cell(env, list, &head, &tail)) {
+            if (!enif_is_ref(env, head)) {
+                return false;
+            }
+            data_ref.emplace_back(head);
+            list = tail;
+        }
+    } else {
+        return false;
     }
+    return true;
+}
 
-    auto statement = res_type::allocate_resource(env, error);
-    if (statement == nullptr) {
-        return error;
+// Prepends the elements of `list` to `tail`. The list is walked once into
+// `scratch` and its elements are consed onto `tail` from back to front,
+// so concatenating all batches of a column is linear in the number of values.
+static bool prepend_list(ErlNifEnv *env, ERL_NIF_TERM list, ERL_NIF_TERM tail, std::vector<ERL_NIF_TERM> &scratch, ERL_NIF_TERM &out) {
+    unsigned length = 0;
+    if (!enif_get_list_length(env, list, &length)) {
+        return false;
     }
 
-    struct AdbcError adbc_error{};
-    AdbcStatusCode code = AdbcStatementNew(&connection->val, &statement->val, &adbc_error);
-    if (code != ADBC_STATUS_OK) {
-        return nif_error_from_adbc_error(env, &adbc_error);
+    scratch.clear();
+    scratch.reserve(length);
+    ERL_NIF_TERM head;
+    while (enif_get_list_cell(env, list, &head, &list)) {
+        scratch.emplace_back(head);
     }
 
-    connection->private_data = &connection->val;
-    enif_keep_resource(&connection->val);
-    ERL_NIF_TERM ret = statement->make_resource(env);
-    return erlang::nif::ok(env, ret);
+    out = tail;
+    for (auto it = scratch.rbegin(); it != scratch.rend(); ++it) {
+        out = enif_make_list_cell(env, *it, out);
+    }
+    return true;
 }
 
-static ERL_NIF_TERM adbc_statement_get_option(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
-    return adbc_get_option<struct AdbcStatement>(
-        env,
-        argv,
-        AdbcStatementGetOption,
-        AdbcStatementGetOptionBytes,
-        AdbcStatementGetOptionInt,
-        AdbcStatementGetOptionDouble
-    );
-}
+// Merges the `%{run_ends: binary, values: list}` parts of a column decoded
+// with `ArrowRunEndEncodedMode::Packed`, given in order. The run ends of each
+// part are shifted by the rows of the parts before it, and a run continuing
+// into the next part (same value on both sides) is merged with its first run.
+// @return false if a part is not a packed run-end encoded map
+static bool merge_packed_run_end_encoded(ErlNifEnv *env, const std::vector<ERL_NIF_TERM> &parts, ERL_NIF_TERM &out) {
+    std::vector<int64_t> run_ends;
+    std::vector<ERL_NIF_TERM> values;
+    int64_t rows = 0;
+    for (auto part : parts) {
+        ERL_NIF_TERM run_ends_term, values_term, head;
+        ErlNifBinary bytes;
+        if (!enif_get_map_value(env, part, kAtomRunEnds, &run_ends_term) ||
+            !enif_get_map_value(env, part, kAtomValues, &values_term) ||
+            !enif_inspect_binary(env, run_ends_term, &bytes) ||
+            bytes.size % sizeof(int64_t) != 0) {
+            return false;
+        }
 
-static ERL_NIF_TERM adbc_statement_set_option(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
-    return adbc_set_option<struct AdbcStatement>(
-        env,
-        argv,
-        AdbcStatementSetOption,
-        AdbcStatementSetOptionBytes,
-        AdbcStatementSetOptionInt,
-        AdbcStatementSetOptionDouble
-    );
+        int64_t part_rows = 0;
+        for (size_t i = 0; i < bytes.size / sizeof(int64_t); i++) {
+            if (!enif_get_list_cell(env, values_term, &head, &values_term)) {
+                return false;
+            }
+            part_rows = get_packed_run_end(bytes.data + i * sizeof(int64_t));
+            if (i == 0 && !values.empty() && enif_is_identical(values.back(), head)) {
+                run_ends.back() = rows + part_rows;
+            } else {
+                run_ends.emplace_back(rows + part_rows);
+                values.emplace_back(head);
+            }
+        }
+        rows += part_rows;
+    }
+
+    ERL_NIF_TERM run_ends_term;
+    auto packed = enif_make_new_binary(env, run_ends.size() * sizeof(int64_t), &run_ends_term);
+    for (size_t i = 0; i < run_ends.size(); i++) {
+        put_packed_run_end(packed + i * sizeof(int64_t), run_ends[i]);
+    }
+    ERL_NIF_TERM keys[] = { kAtomRunEnds, kAtomValues };
+    ERL_NIF_TERM data[] = { run_ends_term, enif_make_list_from_array(env, values.data(), (unsigned)values.size()) };
+    enif_make_map_from_arrays(env, keys, data, 2, &out);
+    return true;
 }
 
-static ERL_NIF_TERM adbc_statement_execute_query(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
-    using res_type = NifRes<struct AdbcStatement>;
-    using array_stream_type = NifRes<struct ArrowArrayStream>;
+// Number of rows of a batch decoded at a time by adbc_column_materialize
+// before checking how much of its timeslice has been used
+constexpr int64_t kMaterializeRowsPerStep = 4096;
 
-    ERL_NIF_TERM error{};
+// Number of values (rows and the items of nested lists) a step on a normal
+// scheduler may decode. Batches or single rows over it are decoded on a
+// dirty CPU scheduler instead.
+constexpr int64_t kMaterializeValuesPerStep = 16384;
 
-    res_type * statement = nullptr;
-    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
-        return error;
+// Number of list elements consed by one step of the final concatenation
+constexpr int64_t kMaterializeConcatPerStep = 65536;
+
+// Estimates the number of values decoding `count` rows of `values` from
+// `offset` produces, following the offsets of (nested) lists and maps and
+// the children of structs and sparse unions. Children that are not indexed
+// by row (dense unions, list views, run-end encoded values) count whole.
+// Stops as soon as the estimate reaches `limit`.
+static int64_t arrow_array_decode_cost(const struct ArrowArray * values, const ArrowDecoderPlan &plan, int64_t offset, int64_t count, int64_t limit) {
+    int64_t cost = count;
+    if (values == nullptr || count <= 0) return 0;
+    if (values->dictionary != nullptr) {
+        cost += values->dictionary->length;
+    }
+    if (cost >= limit || values->n_children <= 0 || values->children == nullptr || (int64_t)plan.children.size() != values->n_children) {
+        return cost;
     }
 
-    auto array_stream = array_stream_type::allocate_resource(env, error);
-    if (array_stream == nullptr) {
-        return error;
+    auto child_cost = [&](int64_t child_i, int64_t child_offset, int64_t child_count) -> void {
+        if (cost < limit && child_count > 0) {
+            cost += arrow_array_decode_cost(values->children[child_i], plan.children[child_i], child_offset, child_count, limit - cost);
+        }
+    };
+    switch (plan.kind) {
+        case ArrowDecoderKind::List:
+        case ArrowDecoderKind::Map: {
+            if (values->n_buffers < 2 || values->buffers[1] == nullptr) break;
+            const int32_t * offsets = (const int32_t *)values->buffers[1];
+            child_cost(0, offsets[offset], (int64_t)offsets[offset + count] - offsets[offset]);
+            break;
+        }
+        case ArrowDecoderKind::LargeList: {
+            if (values->n_buffers < 2 || values->buffers[1] == nullptr) break;
+            const int64_t * offsets = (const int64_t *)values->buffers[1];
+            child_cost(0, offsets[offset], offsets[offset + count] - offsets[offset]);
+            break;
+        }
+        case ArrowDecoderKind::FixedSizeList:
+            child_cost(0, offset * plan.fixed_size, count * plan.fixed_size);
+            break;
+        case ArrowDecoderKind::Struct:
+        case ArrowDecoderKind::SparseUnion:
+            for (int64_t child_i = 0; child_i < values->n_children; child_i++) {
+                child_cost(child_i, offset, count);
+            }
+            break;
+        default:
+            for (int64_t child_i = 0; child_i < values->n_children; child_i++) {
+                if (values->children[child_i] != nullptr) {
+                    child_cost(child_i, 0, values->children[child_i]->length);
+                }
+            }
+            break;
     }
+    return cost;
+}
 
-    int64_t rows_affected = 0;
-    struct AdbcError adbc_error{};
-    AdbcStatusCode code = AdbcStatementExecuteQuery(&statement->val, &array_stream->val, &rows_affected, &adbc_error);
-    if (code != ADBC_STATUS_OK) {
-        return nif_error_from_adbc_error(env, &adbc_error);
+// Whether the decoded data of a batch is one term per row, so that a batch
+// can be decoded a few rows at a time and the parts concatenated afterwards
+static bool is_row_sliceable(const struct ArrowSchema * schema, const ArrowDecoderPlan * plan, const ArrowDecodeOptions &options) {
+    if (plan == nullptr || schema->dictionary != nullptr) {
+        return false;
+    }
+    if (plan->kind == ArrowDecoderKind::RunEndEncoded) {
+        // runs are found with a binary search, so each step only decodes its rows
+        return options.run_end_encoded == ArrowRunEndEncodedMode::Decode && plan->children.size() == 2 && is_arrow_decoder_plan_row_wise(plan->children[1]);
     }
+    return is_arrow_decoder_plan_row_wise(*plan);
+}
 
-    ERL_NIF_TERM ret = array_stream->make_resource(env);
-    return enif_make_tuple3(env,
-        erlang::nif::ok(env),
-        ret,
-        enif_make_int64(env, rows_affected)
-    );
+// Picks the rows of a batch the next step decodes, halving the number of
+// rows until their estimated cost fits in a step.
+// @return true if they still do not fit and must be decoded on a dirty scheduler
+static bool get_materialize_step_rows(const struct ArrowArrayStreamRecord &record, const ArrowDecodeOptions &options, int64_t row_offset, int64_t &count) {
+    const ArrowDecoderPlan * plan = record.plan;
+    int64_t length = record.values->length;
+    if (!is_row_sliceable(record.schema, plan, options)) {
+        count = -1;
+        return plan == nullptr || arrow_array_decode_cost(record.values, *plan, 0, length, kMaterializeValuesPerStep + 1) > kMaterializeValuesPerStep;
+    }
+    if (plan->kind == ArrowDecoderKind::RunEndEncoded) {
+        // only the values of the runs in the step are decoded
+        count = std::min(kMaterializeRowsPerStep, length - row_offset);
+        return false;
+    }
+
+    count = std::min(kMaterializeRowsPerStep, length - row_offset);
+    int64_t cost = arrow_array_decode_cost(record.values, *plan, row_offset, count, kMaterializeValuesPerStep + 1);
+    while (count > 1 && cost > kMaterializeValuesPerStep) {
+        count /= 2;
+        cost = arrow_array_decode_cost(record.values, *plan, row_offset, count, kMaterializeValuesPerStep + 1);
+    }
+    return cost > kMaterializeValuesPerStep;
 }
 
-static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+// Reports the time used since `started` to the scheduler.
+// @return true if the timeslice is used up and the NIF should yield
+static bool consume_materialize_timeslice(ErlNifEnv *env, ErlNifTime &started) {
+    // a timeslice is about 1ms, that is 10us per percent
+    ErlNifTime now = enif_monotonic_time(ERL_NIF_USEC);
+    int percent = (int)((now - started) / 10);
+    if (percent > 0) {
+        started = now;
+        return enif_consume_timeslice(env, percent > 100 ? 100 : percent);
+    }
+    return false;
+}
+
+// Reads the options of adbc_column_materialize and adbc_columns_materialize,
+// `%{zero_copy: boolean(), decode_dictionary: boolean(), run_end_encoded: :columns | :decode | :packed,
+// plain_lists: boolean()}`, all of them optional. The owner of binaries and the dictionary cache are
+// set per record by the callers.
+static bool get_materialize_options(ErlNifEnv *env, ERL_NIF_TERM term, bool &zero_copy, ArrowDecodeOptions &options) {
+    if (!enif_is_map(env, term)) {
+        return false;
+    }
+
+    ERL_NIF_TERM option_term;
+    zero_copy = enif_get_map_value(env, term, kAtomZeroCopy, &option_term) && enif_is_identical(option_term, kAtomTrue);
+    options.decode_dictionary = enif_get_map_value(env, term, kAtomDecodeDictionary, &option_term) && enif_is_identical(option_term, kAtomTrue);
+    options.plain_lists = enif_get_map_value(env, term, kAtomPlainLists, &option_term) && enif_is_identical(option_term, kAtomTrue);
+    options.run_end_encoded = ArrowRunEndEncodedMode::Columns;
+    if (enif_get_map_value(env, term, kAdbcColumnTypeRunEndEncoded, &option_term)) {
+        if (enif_is_identical(option_term, kAtomDecode)) {
+            options.run_end_encoded = ArrowRunEndEncodedMode::Decode;
+        } else if (enif_is_identical(option_term, kAtomPacked)) {
+            options.run_end_encoded = ArrowRunEndEncodedMode::Packed;
+        } else if (!enif_is_identical(option_term, kAtomColumns)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Concatenates the decoded parts of a column a step at a time, yielding
+// back to the scheduler with enif_schedule_nif like materialize_column_step.
+//
+//   argv[0]: the parts left to prepend, last one first
+//   argv[1]: the concatenation of the parts already prepended
+//   argv[2]: the rest of the part being prepended, or []
+//   argv[3]: the values of that part already walked, in reverse order
+//
+// Parts of up to kMaterializeConcatPerStep values are prepended at once
+// with prepend_list. Larger ones are walked into `argv[3]` first and then
+// consed onto `argv[1]`, both a step at a time.
+static ERL_NIF_TERM materialize_column_concat_step(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    ERL_NIF_TERM parts = argv[0];
+    ERL_NIF_TERM ret = argv[1];
+    ERL_NIF_TERM part_rest = argv[2];
+    ERL_NIF_TERM reversed = argv[3];
+    bool on_dirty = enif_thread_type() != ERL_NIF_THR_NORMAL_SCHEDULER;
+
+    std::vector<ERL_NIF_TERM> scratch;
+    ERL_NIF_TERM head, part;
+    ErlNifTime started = enif_monotonic_time(ERL_NIF_USEC);
+    while (true) {
+        if (!enif_is_empty_list(env, part_rest)) {
+            for (int64_t i = 0; i < kMaterializeConcatPerStep && enif_get_list_cell(env, part_rest, &head, &part_rest); i++) {
+                reversed = enif_make_list_cell(env, head, reversed);
+            }
+        } else if (!enif_is_empty_list(env, reversed)) {
+            for (int64_t i = 0; i < kMaterializeConcatPerStep && enif_get_list_cell(env, reversed, &head, &reversed); i++) {
+                ret = enif_make_list_cell(env, head, ret);
+            }
+        } else if (enif_get_list_cell(env, parts, &part, &parts)) {
+            if (!enif_is_list(env, part)) {
+                return erlang::nif::error(env, "cannot materialize a column with multiple batches of non-list data");
+            }
+            // walk at most kMaterializeConcatPerStep cells to tell small parts apart
+            int64_t length = 0;
+            ERL_NIF_TERM cell = part;
+            while (length <= kMaterializeConcatPerStep && enif_get_list_cell(env, cell, &head, &cell)) {
+                length++;
+            }
+            if (on_dirty || length <= kMaterializeConcatPerStep) {
+                if (!prepend_list(env, part, ret, scratch, ret)) {
+                    return erlang::nif::error(env, "cannot materialize a column with multiple batches of non-list data");
+                }
+            } else {
+                part_rest = part;
+            }
+        } else {
+            return erlang::nif::ok(env, ret);
+        }
+
+        if (!on_dirty && consume_materialize_timeslice(env, started)) {
+            ERL_NIF_TERM next[] = {parts, ret, part_rest, reversed};
+            return enif_schedule_nif(env, "adbc_column_materialize", 0, materialize_column_concat_step, 4, next);
+        }
+    }
+}
+
+// Merges the packed run-end encoded parts of a column, last one first,
+// on a dirty CPU scheduler, see merge_packed_run_end_encoded.
+static ERL_NIF_TERM materialize_column_merge_runs(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    std::vector<ERL_NIF_TERM> parts;
+    ERL_NIF_TERM part, rest = argv[0];
+    while (enif_get_list_cell(env, rest, &part, &rest)) {
+        parts.emplace_back(part);
+    }
+    std::reverse(parts.begin(), parts.end());
+
+    ERL_NIF_TERM ret;
+    if (!merge_packed_run_end_encoded(env, parts, ret)) {
+        return erlang::nif::error(env, "cannot materialize a column with multiple batches of non-list data");
+    }
+    return erlang::nif::ok(env, ret);
+}
+
+// Decodes the batches of a column a step at a time, yielding back to the
+// scheduler with enif_schedule_nif whenever its timeslice is used up.
+//
+// Batches that cannot be decoded a few rows at a time (dictionaries,
+// structs, maps, unions, list views...) and rows with too many nested
+// values are decoded on a dirty CPU scheduler, which hands the rest back
+// to a normal one, see get_materialize_step_rows.
+//
+// All the state is kept in the arguments:
+//
+//   argv[0]: the references of the batches left to decode
+//   argv[1]: the number of rows of the first of them already decoded
+//   argv[2]: the decode options, see get_materialize_options
+//   argv[3]: the decoded parts, last one first
+static ERL_NIF_TERM materialize_column_step(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+    record_type * res = nullptr;
+
+    ERL_NIF_TERM refs = argv[0];
+    int64_t row_offset = 0;
+    if (!enif_get_int64(env, argv[1], &row_offset)) {
+        return enif_make_badarg(env);
+    }
+    bool zero_copy = false;
+    ArrowDecodeOptions options;
+    if (!get_materialize_options(env, argv[2], zero_copy, options)) {
+        return enif_make_badarg(env);
+    }
+    ERL_NIF_TERM parts = argv[3];
+    bool on_dirty = enif_thread_type() != ERL_NIF_THR_NORMAL_SCHEDULER;
+
+    ERL_NIF_TERM error{};
+    ERL_NIF_TERM ref, rest;
+    ErlNifTime started = enif_monotonic_time(ERL_NIF_USEC);
+    while (enif_get_list_cell(env, refs, &ref, &rest)) {
+        if ((res = record_type::get_resource(env, ref, error)) == nullptr) {
+            return error;
+        }
+        if (res->val.schema == nullptr || res->val.values == nullptr) {
+            return enif_make_badarg(env);
+        }
+
+        int64_t length = res->val.values->length;
+        int64_t count = -1;
+        bool heavy = get_materialize_step_rows(res->val, options, row_offset, count);
+        if (count == -1) {
+            row_offset = 0;
+        }
+        if (heavy != on_dirty) {
+            // move to the scheduler this step belongs to
+            ERL_NIF_TERM next[] = {refs, enif_make_int64(env, row_offset), argv[2], parts};
+            return enif_schedule_nif(env, "adbc_column_materialize", heavy ? ERL_NIF_DIRTY_JOB_CPU_BOUND : 0, materialize_column_step, 4, next);
+        }
+
+        std::vector<ERL_NIF_TERM> out_terms;
+        constexpr int level = 0;
+        ERL_NIF_TERM out_type;
+        ERL_NIF_TERM out_metadata;
+        // values will be sub-binaries of the record's buffers,
+        // which keep the record resource alive
+        options.binary_owner = zero_copy ? res : nullptr;
+        options.dictionary_cache = res->val.plan_owner != nullptr ? &res->val.plan_owner->dictionaries : nullptr;
+        if (arrow_array_to_nif_term(env, res->val.schema, res->val.values, row_offset, count, level, out_terms, out_type, out_metadata, error, false, res->val.plan, &options) != 0) {
+            return error;
+        }
+        parts = enif_make_list_cell(env, out_terms.size() == 1 ? out_terms[0] : out_terms[1], parts);
+
+        if (count == -1 || row_offset + count >= length) {
+            refs = rest;
+            row_offset = 0;
+        } else {
+            row_offset += count;
+        }
+
+        if (!on_dirty && consume_materialize_timeslice(env, started)) {
+            ERL_NIF_TERM next[] = {refs, enif_make_int64(env, row_offset), argv[2], parts};
+            return enif_schedule_nif(env, "adbc_column_materialize", 0, materialize_column_step, 4, next);
+        }
+    }
+
+    ERL_NIF_TERM last;
+    if (enif_get_list_cell(env, parts, &last, &rest) && enif_is_empty_list(env, rest)) {
+        return erlang::nif::ok(env, last);
+    }
+
+    // packed run-end encoded parts are merged, not concatenated
+    if (enif_is_map(env, last)) {
+        ERL_NIF_TERM merge_argv[] = {parts};
+        if (on_dirty) {
+            return materialize_column_merge_runs(env, 1, merge_argv);
+        }
+        return enif_schedule_nif(env, "adbc_column_materialize", ERL_NIF_DIRTY_JOB_CPU_BOUND, materialize_column_merge_runs, 1, merge_argv);
+    }
+
+    // concatenate the parts, starting from the last one
+    ERL_NIF_TERM concat_argv[] = {parts, enif_make_list(env, 0), enif_make_list(env, 0), enif_make_list(env, 0)};
+    return materialize_column_concat_step(env, 4, concat_argv);
+}
+
+// Runs on a normal scheduler: small columns are decoded in a single call,
+// large ones yield between steps and the batches or rows too costly for a
+// step are moved to a dirty scheduler, see materialize_column_step.
+static ERL_NIF_TERM adbc_column_materialize(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    std::vector<ERL_NIF_TERM> data_ref;
+    if (!get_column_data_refs(env, argv[0], data_ref)) {
+        return enif_make_badarg(env);
+    }
+
+    // optional decode options, see get_materialize_options
+    ERL_NIF_TERM options = enif_make_new_map(env);
+    if (argc == 2) {
+        bool zero_copy;
+        ArrowDecodeOptions decode_options;
+        if (!get_materialize_options(env, argv[1], zero_copy, decode_options)) {
+            return enif_make_badarg(env);
+        }
+        options = argv[1];
+    }
+
+    ERL_NIF_TERM step_argv[] = {
+        enif_make_list_from_array(env, data_ref.data(), (unsigned)data_ref.size()),
+        enif_make_int64(env, 0),
+        options,
+        enif_make_list(env, 0),
+    };
+    return materialize_column_step(env, 4, step_argv);
+}
+
+// One batch of one column, decoded by a worker into its own environment
+struct MaterializeTask {
+    NifRes<struct ArrowArrayStreamRecord> * res = nullptr;
+    ErlNifEnv * env = nullptr;
+    ERL_NIF_TERM data{};
+    ERL_NIF_TERM error{};
+    int ret = 0;
+};
+
+// The batches of one adbc_columns_materialize call. The records are kept
+// alive until the reply is sent by the worker finishing the last batch.
+struct MaterializeJob {
+    // the number of batches of each column, in order
+    std::vector<size_t> column_tasks;
+    std::vector<MaterializeTask> tasks;
+    std::atomic<size_t> pending{0};
+    ErlNifPid pid;
+    ErlNifEnv * msg_env = nullptr;
+    ERL_NIF_TERM ref{};
+
+    ~MaterializeJob() {
+        for (auto &task : tasks) {
+            if (task.env) enif_free_env(task.env);
+            if (task.res) enif_release_resource(task.res);
+        }
+        if (msg_env) enif_free_env(msg_env);
+    }
+};
+
+// Copies the decoded batches into the message environment, concatenated
+// per column, and sends `{ref, {:ok, [data]} | {:error, reason}}` to the
+// caller. `caller_env` is nullptr when called from a worker thread.
+static void finish_materialize_job(ErlNifEnv * caller_env, MaterializeJob * job) {
+    ErlNifEnv * env = job->msg_env;
+    ERL_NIF_TERM ret{};
+    bool failed = false;
+    for (auto &task : job->tasks) {
+        if (task.ret != 0 && !failed) {
+            failed = true;
+            if (task.env == nullptr) {
+                ret = erlang::nif::error(env, "cannot allocate an environment to materialize columns");
+            } else {
+                ret = enif_make_copy(env, task.error);
+            }
+        }
+    }
+
+    if (!failed) {
+        std::vector<ERL_NIF_TERM> materialized;
+        std::vector<ERL_NIF_TERM> scratch;
+        size_t first = 0;
+        for (size_t n_batches : job->column_tasks) {
+            ERL_NIF_TERM data = enif_make_list(env, 0);
+            if (n_batches == 1) {
+                data = enif_make_copy(env, job->tasks[first].data);
+            } else if (enif_is_map(job->tasks[first].env, job->tasks[first].data)) {
+                // packed run-end encoded batches are merged, not concatenated
+                std::vector<ERL_NIF_TERM> parts;
+                for (size_t i = first; i < first + n_batches; i++) {
+                    parts.emplace_back(enif_make_copy(env, job->tasks[i].data));
+                }
+                if (!merge_packed_run_end_encoded(env, parts, data)) {
+                    ret = erlang::nif::error(env, "cannot materialize a column with multiple batches of non-list data");
+                    failed = true;
+                }
+            } else {
+                // concatenate the batches, starting from the last one
+                for (size_t i = first + n_batches; i > first; i--) {
+                    if (!prepend_list(env, enif_make_copy(env, job->tasks[i - 1].data), data, scratch, data)) {
+                        ret = erlang::nif::error(env, "cannot materialize a column with multiple batches of non-list data");
+                        failed = true;
+                        break;
+                    }
+                }
+            }
+            if (failed) break;
+            materialized.emplace_back(data);
+            first += n_batches;
+        }
+        if (!failed) {
+            ret = erlang::nif::ok(env, enif_make_list_from_array(env, materialized.data(), (unsigned)materialized.size()));
+        }
+    }
+
+    enif_send(caller_env, &job->pid, env, enif_make_tuple2(env, job->ref, ret));
+    delete job;
+}
+
+// Materializes several columns at once, decoding all their batches
+// concurrently on a pool of native threads.
+//
+// Returns `:ok` right away, and the caller receives `{ref, result}` once
+// all the batches are decoded, so no scheduler is held while the workers
+// run. Each batch is decoded into a process independent environment,
+// which is then copied into the message and concatenated per column.
+// `result` is `{:ok, [data]}` in the order of the given columns.
+static ERL_NIF_TERM adbc_columns_materialize(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+
+    // decode options, see get_materialize_options, and `workers: pos_integer()`
+    bool zero_copy = false;
+    ArrowDecodeOptions decode_options;
+    int n_workers = 1;
+    ERL_NIF_TERM option_term;
+    if (!get_materialize_options(env, argv[1], zero_copy, decode_options)) {
+        return enif_make_badarg(env);
+    }
+    if (enif_get_map_value(env, argv[1], kAtomWorkers, &option_term)) {
+        if (!enif_get_int(env, option_term, &n_workers) || n_workers < 1) {
+            return enif_make_badarg(env);
+        }
+    }
+    if (!enif_is_ref(env, argv[2])) {
+        return enif_make_badarg(env);
+    }
+
+    std::vector<size_t> column_tasks;
+    std::vector<MaterializeTask> tasks;
+    ERL_NIF_TERM error{};
+    ERL_NIF_TERM column, columns = argv[0];
+    while (enif_get_list_cell(env, columns, &column, &columns)) {
+        std::vector<ERL_NIF_TERM> data_ref;
+        if (!get_column_data_refs(env, column, data_ref)) {
+            return enif_make_badarg(env);
+        }
+        column_tasks.emplace_back(data_ref.size());
+        for (auto &ref : data_ref) {
+            MaterializeTask task;
+            if ((task.res = record_type::get_resource(env, ref, error)) == nullptr) {
+                return error;
+            }
+            if (task.res->val.schema == nullptr || task.res->val.values == nullptr) {
+                return enif_make_badarg(env);
+            }
+            tasks.emplace_back(task);
+        }
+    }
+
+    AdbcThreadPool * pool = get_thread_pool(&materialize_pool, "adbc_materialize", n_workers);
+    if (pool == nullptr) {
+        return erlang::nif::error(env, "cannot start the native workers to materialize columns");
+    }
+
+    auto job = new (std::nothrow) MaterializeJob();
+    if (job == nullptr || enif_self(env, &job->pid) == nullptr || (job->msg_env = enif_alloc_env()) == nullptr) {
+        delete job;
+        return erlang::nif::error(env, "cannot materialize the columns asynchronously");
+    }
+    job->ref = enif_make_copy(job->msg_env, argv[2]);
+    job->column_tasks = std::move(column_tasks);
+    job->tasks = std::move(tasks);
+    for (auto &task : job->tasks) {
+        enif_keep_resource(task.res);
+    }
+
+    if (job->tasks.empty()) {
+        finish_materialize_job(env, job);
+        return erlang::nif::ok(env);
+    }
+
+    job->pending.store(job->tasks.size(), std::memory_order_relaxed);
+    for (size_t i = 0; i < job->tasks.size(); i++) {
+        pool->submit([job, i, zero_copy, decode_options]() {
+            MaterializeTask * t = &job->tasks[i];
+            t->env = enif_alloc_env();
+            if (t->env == nullptr) {
+                t->ret = 1;
+            } else {
+                std::vector<ERL_NIF_TERM> out_terms;
+                constexpr int level = 0;
+                ERL_NIF_TERM out_type;
+                ERL_NIF_TERM out_metadata;
+                ArrowDecodeOptions options = decode_options;
+                options.binary_owner = zero_copy ? t->res : nullptr;
+                options.dictionary_cache = t->res->val.plan_owner != nullptr ? &t->res->val.plan_owner->dictionaries : nullptr;
+                t->ret = arrow_array_to_nif_term(t->env, t->res->val.schema, t->res->val.values, level, out_terms, out_type, out_metadata, t->error, false, t->res->val.plan, &options);
+                if (t->ret == 0) {
+                    t->data = out_terms.size() == 1 ? out_terms[0] : out_terms[1];
+                }
+            }
+
+            if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                finish_materialize_job(nullptr, job);
+            }
+        });
+    }
+    return erlang::nif::ok(env);
+}
+
+static ERL_NIF_TERM adbc_column_to_binary(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using record_type = NifRes<struct ArrowArrayStreamRecord>;
+
+    std::vector<ERL_NIF_TERM> data_ref;
+    if (!get_column_data_refs(env, argv[0], data_ref)) {
+        return enif_make_badarg(env);
+    }
+
+    std::vector<record_type *> records;
+    ERL_NIF_TERM error{};
+    int64_t value_bytes = -1;
+    int64_t total_length = 0;
+    bool has_nulls = false;
+    for (auto& ref : data_ref) {
+        record_type * res = nullptr;
+        if ((res = record_type::get_resource(env, ref, error)) == nullptr) {
+            return error;
+        }
+        struct ArrowSchema * schema = res->val.schema;
+        struct ArrowArray * values = res->val.values;
+        if (schema == nullptr || values == nullptr) {
+            return enif_make_badarg(env);
+        }
+        if (schema->dictionary != nullptr) {
+            return erlang::nif::error(env, "cannot convert a dictionary encoded column to binary");
+        }
+
+        int64_t bytes;
+        if (res->val.plan != nullptr) {
+            bytes = arrow_fixed_width_bytes(*res->val.plan);
+        } else {
+            ArrowDecoderPlan plan;
+            compile_arrow_decoder_plan_format(schema->format, plan);
+            bytes = arrow_fixed_width_bytes(plan);
+        }
+        if (bytes <= 0 || values->n_buffers != 2) {
+            char err_msg_buf[256] = { '\0' };
+            snprintf(err_msg_buf, 255, "cannot convert column of format %s to binary, only fixed width types are supported", schema->format);
+            return erlang::nif::error(env, err_msg_buf);
+        }
+        if (value_bytes != -1 && value_bytes != bytes) {
+            return erlang::nif::error(env, "cannot convert column to binary, its batches have different types");
+        }
+        value_bytes = bytes;
+
+        if (values->buffers[0] != nullptr && values->null_count != 0) {
+            has_nulls = true;
+        }
+        total_length += values->length;
+        records.emplace_back(res);
+    }
+
+    ERL_NIF_TERM data_term;
+    if (records.size() == 1 && total_length > 0) {
+        // a single batch is handed over as is, owned by its record
+        struct ArrowArray * values = records[0]->val.values;
+        const uint8_t * data = (const uint8_t *)values->buffers[1] + values->offset * value_bytes;
+        data_term = enif_make_resource_binary(env, records[0], data, (size_t)(values->length * value_bytes));
+    } else {
+        unsigned char * ptr = enif_make_new_binary(env, (size_t)(total_length * value_bytes), &data_term);
+        if (ptr == nullptr) {
+            return erlang::nif::error(env, "out of memory");
+        }
+        for (auto res : records) {
+            struct ArrowArray * values = res->val.values;
+            if (values->length == 0) continue;
+            size_t nbytes = (size_t)(values->length * value_bytes);
+            memcpy(ptr, (const uint8_t *)values->buffers[1] + values->offset * value_bytes, nbytes);
+            ptr += nbytes;
+        }
+    }
+
+    ERL_NIF_TERM validity_term = kAtomNil;
+    if (has_nulls) {
+        size_t validity_bytes = (size_t)((total_length + 7) / 8);
+        unsigned char * ptr = enif_make_new_binary(env, validity_bytes, &validity_term);
+        if (ptr == nullptr) {
+            return erlang::nif::error(env, "out of memory");
+        }
+        memset(ptr, 0, validity_bytes);
+
+        int64_t bit_offset = 0;
+        for (auto res : records) {
+            struct ArrowArray * values = res->val.values;
+            copy_arrow_validity_bitmap(ptr, bit_offset, (const uint8_t *)values->buffers[0], values->offset, values->length);
+            bit_offset += values->length;
+        }
+    }
+
+    return erlang::nif::ok(env, enif_make_tuple2(env, data_term, validity_term));
+}
+
+static ERL_NIF_TERM adbc_arrow_array_stream_release(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct ArrowArrayStream>;
+    ERL_NIF_TERM error{};
+
+    res_type * res = nullptr;
+    if ((res = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    // the statement or connection the stream came from, if given, is kept
+    // by a prefetcher whose reader may still be in `get_next` until it exits
+    void * owner = nullptr;
+    if (!enif_is_identical(argv[1], kAtomNil) &&
+        !enif_get_resource(env, argv[1], NifRes<struct AdbcStatement>::type, &owner) &&
+        !enif_get_resource(env, argv[1], NifRes<struct AdbcConnection>::type, &owner)) {
+        return enif_make_badarg(env);
+    }
+
+    // a prefetcher owns the stream and releases it once its reader exits
+    bool detached = false;
+    auto private_data = (struct ArrowArrayStreamPrivateData *)res->private_data;
+    if (private_data != nullptr && private_data->prefetcher != nullptr) {
+        detached = ArrowArrayStreamPrefetcher::detach(private_data->prefetcher, get_cleanup_pool(), owner);
+        private_data->prefetcher = nullptr;
+    }
+
+    if (res->val.release) {
+        res->val.release(&res->val);
+        res->val.release = nullptr;
+    }
+
+    if (detached) {
+        return erlang::nif::ok(env, enif_make_atom(env, "detached"));
+    }
+    return erlang::nif::ok(env);
+}
+
+static ERL_NIF_TERM adbc_arrow_array_stream_queue_new(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using producer_type = NifRes<struct ArrowArrayStreamQueueProducer>;
+    using stream_type = NifRes<struct ArrowArrayStream>;
+
+    ERL_NIF_TERM error{};
+    unsigned capacity = 0;
+    if (!enif_get_uint(env, argv[0], &capacity) || capacity == 0) {
+        return enif_make_badarg(env);
+    }
+
+    auto queue = ArrowArrayStreamQueue::create(capacity);
+    if (queue == nullptr) {
+        return erlang::nif::error(env, "cannot allocate stream queue");
+    }
+
+    producer_type * producer = nullptr;
+    if ((producer = producer_type::allocate_resource(env, error)) == nullptr) {
+        queue->release();
+        return error;
+    }
+    // the producer takes the reference returned by `create`
+    producer->val.queue = queue;
+    ERL_NIF_TERM producer_term = producer->make_resource(env);
+    enif_release_resource(producer);
+
+    stream_type * stream = nullptr;
+    if ((stream = stream_type::allocate_resource(env, error)) == nullptr) {
+        return error;
+    }
+    queue->export_to(&stream->val);
+    ERL_NIF_TERM stream_term = stream->make_resource(env);
+    enif_release_resource(stream);
+
+    return erlang::nif::ok(env, enif_make_tuple2(env, producer_term, stream_term));
+}
+
+static ERL_NIF_TERM adbc_arrow_array_stream_queue_push(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using producer_type = NifRes<struct ArrowArrayStreamQueueProducer>;
+
+    ERL_NIF_TERM error{};
+    producer_type * producer = nullptr;
+    if ((producer = producer_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+    if (!enif_is_list(env, argv[1]) || !enif_is_ref(env, argv[2])) {
+        return enif_make_badarg(env);
+    }
+
+    // a full queue is reported before encoding the batch, the caller
+    // pushes it again once it gets `{ref, :ready}`
+    auto queue = producer->val.queue;
+    if (!queue->has_room(env, argv[2])) {
+        return erlang::nif::error(env, kAtomFull);
+    }
+
+    // the batch is encoded on the producer's scheduler, so that the
+    // consumer only moves it out of the queue
+    struct ArrowArray values{};
+    struct ArrowSchema schema{};
+    struct ArrowError arrow_error{};
+    if (adbc_column_to_arrow_type_struct(env, argv[1], &values, &schema, &arrow_error)) {
+        if (values.release) values.release(&values);
+        if (schema.release) schema.release(&schema);
+        return erlang::nif::error(env, arrow_error.message);
+    }
+
+    std::string reason;
+    int code;
+    // another producer may have filled the queue in the meantime
+    while ((code = queue->push(&values, &schema, reason)) == 3 && queue->has_room(env, argv[2])) {}
+
+    switch (code) {
+        case 0:
+            return erlang::nif::ok(env);
+        case 1:
+            return kAtomClosed;
+        case 3:
+            values.release(&values);
+            schema.release(&schema);
+            return erlang::nif::error(env, kAtomFull);
+        default:
+            return erlang::nif::error(env, reason.c_str());
+    }
+}
+
+static ERL_NIF_TERM adbc_arrow_array_stream_queue_finish(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using producer_type = NifRes<struct ArrowArrayStreamQueueProducer>;
+
+    ERL_NIF_TERM error{};
+    producer_type * producer = nullptr;
+    if ((producer = producer_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    if (enif_is_identical(argv[1], kAtomNil)) {
+        producer->val.queue->finish(0, "");
+    } else {
+        std::string reason;
+        if (!erlang::nif::get(env, argv[1], reason)) {
+            return enif_make_badarg(env);
+        }
+        producer->val.queue->finish(EIO, reason);
+    }
+    return erlang::nif::ok(env);
+}
+
+static ERL_NIF_TERM adbc_statement_new(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcStatement>;
+    using connection_type = NifRes<struct AdbcConnection>;
 
     ERL_NIF_TERM error{};
 
+    connection_type * connection = nullptr;
+    if ((connection = connection_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    auto statement = res_type::allocate_resource(env, error);
+    if (statement == nullptr) {
+        return error;
+    }
+
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = AdbcStatementNew(&connection->val, &statement->val, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+
+    connection->private_data = &connection->val;
+    enif_keep_resource(&connection->val);
+    ERL_NIF_TERM ret = statement->make_resource(env);
+    return erlang::nif::ok(env, ret);
+}
+
+// Releases the statement before it is garbage collected,
+// it cannot be used afterwards
+static ERL_NIF_TERM adbc_statement_release(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
     res_type * statement = nullptr;
     if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
         return error;
     }
 
+    if (statement->val.private_driver != nullptr) {
+        struct AdbcError adbc_error{};
+        AdbcStatusCode code = AdbcStatementRelease(&statement->val, &adbc_error);
+        if (code != ADBC_STATUS_OK) {
+            return nif_error_from_adbc_error(env, &adbc_error);
+        }
+    }
+    return erlang::nif::ok(env);
+}
+
+static ERL_NIF_TERM adbc_statement_get_option(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    return adbc_get_option<struct AdbcStatement>(
+        env,
+        argv,
+        AdbcStatementGetOption,
+        AdbcStatementGetOptionBytes,
+        AdbcStatementGetOptionInt,
+        AdbcStatementGetOptionDouble
+    );
+}
+
+static ERL_NIF_TERM adbc_statement_set_option(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    return adbc_set_option<struct AdbcStatement>(
+        env,
+        argv,
+        AdbcStatementSetOption,
+        AdbcStatementSetOptionBytes,
+        AdbcStatementSetOptionInt,
+        AdbcStatementSetOptionDouble
+    );
+}
+
+static ERL_NIF_TERM statement_execute_query(ErlNifEnv *env, NifRes<struct AdbcStatement> * statement) {
+    using array_stream_type = NifRes<struct ArrowArrayStream>;
+
+    ERL_NIF_TERM error{};
+    auto array_stream = array_stream_type::allocate_resource(env, error);
+    if (array_stream == nullptr) {
+        return error;
+    }
+
+    int64_t rows_affected = 0;
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = AdbcStatementExecuteQuery(&statement->val, &array_stream->val, &rows_affected, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+
+    ERL_NIF_TERM ret = array_stream->make_resource(env);
+    return enif_make_tuple3(env,
+        erlang::nif::ok(env),
+        ret,
+        enif_make_int64(env, rows_affected)
+    );
+}
+
+static ERL_NIF_TERM statement_execute(ErlNifEnv *env, NifRes<struct AdbcStatement> * statement) {
     int64_t rows_affected = 0;
     struct AdbcError adbc_error{};
     AdbcStatusCode code = AdbcStatementExecuteQuery(&statement->val, nullptr, &rows_affected, &adbc_error);
@@ -725,6 +1875,76 @@ static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_N
     );
 }
 
+static ERL_NIF_TERM adbc_statement_execute_query(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    return statement_execute_query(env, statement);
+}
+
+static ERL_NIF_TERM adbc_statement_execute(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    return statement_execute(env, statement);
+}
+
+// Same as `adbc_statement_execute_query` and `adbc_statement_execute`,
+// but run on the executor pool, replying with `{ref, result}`
+template <ERL_NIF_TERM (*Execute)(ErlNifEnv *, NifRes<struct AdbcStatement> *)>
+static ERL_NIF_TERM adbc_statement_run_async(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    AdbcThreadPool * pool = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+    if ((pool = get_async_pool(env, &executor_pool, "adbc_executor", argv[1], argv[2], error)) == nullptr) {
+        return error;
+    }
+
+    enif_keep_resource(statement);
+    return submit_async(env, pool, argv[1], [statement](ErlNifEnv * msg_env) {
+        ERL_NIF_TERM ret = Execute(msg_env, statement);
+        enif_release_resource(statement);
+        return ret;
+    });
+}
+
+// Cancels the query running on the statement, or the reading of its
+// result stream, safe to call while they run on another thread
+static ERL_NIF_TERM adbc_statement_cancel(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = AdbcStatementCancel(&statement->val, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+    return erlang::nif::ok(env);
+}
+
 static ERL_NIF_TERM adbc_statement_prepare(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcStatement>;
 
@@ -768,6 +1988,34 @@ static ERL_NIF_TERM adbc_statement_set_sql_query(ErlNifEnv *env, int argc, const
     return erlang::nif::ok(env);
 }
 
+// Binds the parameters just filled into `params`. If the driver rejects
+// them, the ones of the previous bind are bound again, so the driver
+// never keeps pointers into buffers that the next fill rebuilds.
+static AdbcStatusCode bind_statement_params(struct AdbcStatement * statement, AdbcStatementParams * params, struct AdbcError * error) {
+    struct ArrowArray values{};
+    struct ArrowSchema schema{};
+    params->export_to(&values, &schema);
+    AdbcStatusCode code = AdbcStatementBind(statement, &values, &schema, error);
+    if (values.release) values.release(&values);
+    if (schema.release) schema.release(&schema);
+
+    // without a previous bind to restore, the driver may still hold the
+    // new buffers, so they are kept as if it had accepted them
+    if (code == ADBC_STATUS_OK || !params->has_bound()) {
+        params->commit();
+        return code;
+    }
+
+    struct AdbcError rebind_error{};
+    params->export_bound_to(&values, &schema);
+    if (AdbcStatementBind(statement, &values, &schema, &rebind_error) != ADBC_STATUS_OK && rebind_error.release) {
+        rebind_error.release(&rebind_error);
+    }
+    if (values.release) values.release(&values);
+    if (schema.release) schema.release(&schema);
+    return code;
+}
+
 static ERL_NIF_TERM adbc_statement_bind(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
     using res_type = NifRes<struct AdbcStatement>;
 
@@ -788,10 +2036,110 @@ static ERL_NIF_TERM adbc_statement_bind(ErlNifEnv *env, int argc, const ERL_NIF_
     struct ArrowError arrow_error{};
     struct AdbcError adbc_error{};
     AdbcStatusCode code{};
+    AdbcStatementParams * params = nullptr;
+    unsigned n_items = 0;
+    int fill_code = -1;
     values.release = nullptr;
     schema.release = nullptr;
 
-    if (adbc_column_to_arrow_type_struct(env, argv[1], &values, &schema, &arrow_error)) {
+    // scalar parameters reuse the buffers kept by the statement,
+    // anything else is built from scratch
+    enif_get_list_length(env, argv[1], &n_items);
+    if (n_items > 0) {
+        params = (AdbcStatementParams *)statement->private_data;
+        if (params == nullptr) {
+            params = new AdbcStatementParams();
+            statement->private_data = params;
+        }
+        fill_code = params->fill(env, argv[1], n_items, &arrow_error);
+    }
+
+    if (fill_code == 0) {
+        code = bind_statement_params(&statement->val, params, &adbc_error);
+    } else if (fill_code != -1) {
+        ret = erlang::nif::error(env, arrow_error.message);
+        goto cleanup;
+    } else if (adbc_column_to_arrow_type_struct(env, argv[1], &values, &schema, &arrow_error)) {
+        ret = erlang::nif::error(env, arrow_error.message);
+        goto cleanup;
+    } else {
+        code = AdbcStatementBind(&statement->val, &values, &schema, &adbc_error);
+    }
+
+    if (code != ADBC_STATUS_OK) {
+        ret = nif_error_from_adbc_error(env, &adbc_error);
+        goto cleanup;
+    }
+    ret = erlang::nif::ok(env);
+
+cleanup:
+    if (values.release) values.release(&values);
+    if (schema.release) schema.release(&schema);
+    return ret;
+}
+
+static ERL_NIF_TERM adbc_statement_bind_rows(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    unsigned n_rows = 0;
+    if (!enif_get_list_length(env, argv[1], &n_rows)) {
+        return enif_make_badarg(env);
+    }
+
+    auto params = (AdbcStatementParams *)statement->private_data;
+    if (params == nullptr) {
+        params = new AdbcStatementParams();
+        statement->private_data = params;
+    }
+
+    // the rows are transposed into a single batch, so that the driver
+    // runs the statement for all of them within one execute. If that
+    // fails, the driver keeps the parameters of the previous bind
+    struct ArrowError arrow_error{};
+    if (params->fill_rows(env, argv[1], n_rows, &arrow_error) != 0) {
+        return erlang::nif::error(env, arrow_error.message);
+    }
+
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code = bind_statement_params(&statement->val, params, &adbc_error);
+    if (code != ADBC_STATUS_OK) {
+        return nif_error_from_adbc_error(env, &adbc_error);
+    }
+
+    return erlang::nif::ok(env);
+}
+
+static ERL_NIF_TERM adbc_statement_bind_records(ErlNifEnv *env, int argc, const ERL_NIF_TERM argv[]) {
+    using res_type = NifRes<struct AdbcStatement>;
+
+    ERL_NIF_TERM ret{};
+    ERL_NIF_TERM error{};
+
+    res_type * statement = nullptr;
+    if ((statement = res_type::get_resource(env, argv[0], error)) == nullptr) {
+        return error;
+    }
+
+    if (!enif_is_list(env, argv[1]) || !enif_is_list(env, argv[2])) {
+        return enif_make_badarg(env);
+    }
+
+    struct ArrowArray values{};
+    struct ArrowSchema schema{};
+    struct ArrowError arrow_error{};
+    struct AdbcError adbc_error{};
+    AdbcStatusCode code{};
+    values.release = nullptr;
+    schema.release = nullptr;
+
+    if (adbc_rows_to_arrow_type_struct(env, argv[1], argv[2], &values, &schema, &arrow_error)) {
         ret = erlang::nif::error(env, arrow_error.message);
         goto cleanup;
     }
@@ -836,6 +2184,9 @@ static ERL_NIF_TERM adbc_statement_bind_stream(ErlNifEnv *env, int argc, const E
 static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     ErlNifResourceType *rt;
 
+    thread_pools_mutex = enif_mutex_create((char *)"adbc_thread_pools_mutex");
+    if (!thread_pools_mutex) return -1;
+
     {
         using res_type = NifRes<struct AdbcDatabase>;
         rt = enif_open_resource_type(env, "Elixir.Adbc.Nif", "NifResAdbcDatabase", destruct_adbc_database_resource, ERL_NIF_RT_CREATE, NULL);
@@ -878,6 +2229,13 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
         res_type::type = rt;
     }
 
+    {
+        using res_type = NifRes<struct ArrowArrayStreamQueueProducer>;
+        rt = enif_open_resource_type(env, "Elixir.Adbc.Nif", "NifResArrowArrayStreamQueueProducer", destruct_arrow_array_stream_queue_producer, ERL_NIF_RT_CREATE, NULL);
+        if (!rt) return -1;
+        res_type::type = rt;
+    }
+
     kAtomAdbcError = erlang::nif::atom(env, "adbc_error");
     kAtomNil = erlang::nif::atom(env, "nil");
     kAtomTrue = erlang::nif::atom(env, "true");
@@ -889,6 +2247,16 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     kAtomNaN = erlang::nif::atom(env, "nan");
     kAtomEndOfSeries = erlang::nif::atom(env, "end_of_series");
     kAtomStructKey = erlang::nif::atom(env, "__struct__");
+    kAtomZeroCopy = erlang::nif::atom(env, "zero_copy");
+    kAtomWorkers = erlang::nif::atom(env, "workers");
+    kAtomDecodeDictionary = erlang::nif::atom(env, "decode_dictionary");
+    kAtomColumns = erlang::nif::atom(env, "columns");
+    kAtomDecode = erlang::nif::atom(env, "decode");
+    kAtomPacked = erlang::nif::atom(env, "packed");
+    kAtomPlainLists = erlang::nif::atom(env, "plain_lists");
+    kAtomClosed = erlang::nif::atom(env, "closed");
+    kAtomFull = erlang::nif::atom(env, "full");
+    kAtomReady = erlang::nif::atom(env, "ready");
     kAtomValidity = erlang::nif::atom(env, "validity");
     kAtomOffsets = erlang::nif::atom(env, "offsets");
     kAtomSizes = erlang::nif::atom(env, "sizes");
@@ -926,6 +2294,11 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     kAtomSecondKey = erlang::nif::atom(env, "second");
     kAtomMicrosecondKey = erlang::nif::atom(env, "microsecond");
 
+    kAtomDecimalModule = erlang::nif::atom(env, "Elixir.Decimal");
+    kAtomSignKey = erlang::nif::atom(env, "sign");
+    kAtomCoefKey = erlang::nif::atom(env, "coef");
+    kAtomExpKey = erlang::nif::atom(env, "exp");
+
     kAtomAdbcColumnModule = erlang::nif::atom(env, "Elixir.Adbc.Column");
     kAtomNameKey = erlang::nif::atom(env, "name");
     kAtomTypeKey = erlang::nif::atom(env, "type");
@@ -1004,6 +2377,25 @@ static int on_load(ErlNifEnv *env, void **, ERL_NIF_TERM) {
     return 0;
 }
 
+// The jobs on the pools keep the resources they use, so the library is
+// normally only unloaded once they are done. A pool that is still running
+// a job (a driver call that does not return, for example) is not waited
+// for, so that unloading does not hang, and is left to its workers.
+static void on_unload(ErlNifEnv *, void *) {
+    for (auto pool : {&materialize_pool, &executor_pool, &setup_pool, &cleanup_pool}) {
+        if (*pool) {
+            if ((*pool)->shutdown()) {
+                delete *pool;
+            }
+            *pool = nullptr;
+        }
+    }
+    if (thread_pools_mutex) {
+        enif_mutex_destroy(thread_pools_mutex);
+        thread_pools_mutex = nullptr;
+    }
+}
+
 static int on_reload(ErlNifEnv *, void **, ERL_NIF_TERM) {
     return 0;
 }
@@ -1022,25 +2414,41 @@ static ErlNifFunc nif_functions[] = {
     {"adbc_connection_get_option", 3, adbc_connection_get_option, 0},
     {"adbc_connection_set_option", 4, adbc_connection_set_option, 0},
     {"adbc_connection_init", 2, adbc_connection_init, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_connection_init_async", 4, adbc_connection_init_async, 0},
     {"adbc_connection_get_info", 2, adbc_connection_get_info, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_connection_get_objects", 7, adbc_connection_get_objects, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_connection_get_table_types", 1, adbc_connection_get_table_types, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_connection_cancel", 1, adbc_connection_cancel, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
     {"adbc_statement_new", 1, adbc_statement_new, 0},
+    {"adbc_statement_release", 1, adbc_statement_release, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_get_option", 3, adbc_statement_get_option, 0},
     {"adbc_statement_set_option", 4, adbc_statement_set_option, 0},
     {"adbc_statement_execute_query", 1, adbc_statement_execute_query, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_execute", 1, adbc_statement_execute, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_statement_execute_query_async", 3, adbc_statement_run_async<statement_execute_query>, 0},
+    {"adbc_statement_execute_async", 3, adbc_statement_run_async<statement_execute>, 0},
+    {"adbc_statement_cancel", 1, adbc_statement_cancel, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_prepare", 1, adbc_statement_prepare, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_set_sql_query", 2, adbc_statement_set_sql_query, ERL_NIF_DIRTY_JOB_IO_BOUND},
     {"adbc_statement_bind", 2, adbc_statement_bind, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_statement_bind_rows", 2, adbc_statement_bind_rows, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_statement_bind_records", 3, adbc_statement_bind_records, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_arrow_array_stream_queue_new", 1, adbc_arrow_array_stream_queue_new, 0},
+    {"adbc_arrow_array_stream_queue_push", 3, adbc_arrow_array_stream_queue_push, ERL_NIF_DIRTY_JOB_CPU_BOUND},
+    {"adbc_arrow_array_stream_queue_finish", 2, adbc_arrow_array_stream_queue_finish, 0},
     {"adbc_statement_bind_stream", 2, adbc_statement_bind_stream, ERL_NIF_DIRTY_JOB_IO_BOUND},
 
     {"adbc_arrow_array_stream_get_pointer", 1, adbc_arrow_array_stream_get_pointer, 0},
     {"adbc_arrow_array_stream_next", 1, adbc_arrow_array_stream_next, ERL_NIF_DIRTY_JOB_IO_BOUND},
-    {"adbc_arrow_array_stream_release", 1, adbc_arrow_array_stream_release, ERL_NIF_DIRTY_JOB_IO_BOUND},
-
-    {"adbc_column_materialize", 1, adbc_column_materialize, ERL_NIF_DIRTY_JOB_CPU_BOUND},
+    {"adbc_arrow_array_stream_collect", 3, adbc_arrow_array_stream_collect, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_arrow_array_stream_prefetch", 2, adbc_arrow_array_stream_prefetch, ERL_NIF_DIRTY_JOB_IO_BOUND},
+    {"adbc_arrow_array_stream_release", 2, adbc_arrow_array_stream_release, ERL_NIF_DIRTY_JOB_IO_BOUND},
+
+    {"adbc_column_materialize", 1, adbc_column_materialize, 0},
+    {"adbc_column_materialize", 2, adbc_column_materialize, 0},
+    {"adbc_columns_materialize", 3, adbc_columns_materialize, 0},
+    {"adbc_column_to_binary", 1, adbc_column_to_binary, ERL_NIF_DIRTY_JOB_CPU_BOUND},
 };
 
-ERL_NIF_INIT(Elixir.Adbc.Nif, nif_functions, on_load, on_reload, on_upgrade, NULL);
+ERL_NIF_INIT(Elixir.Adbc.Nif, nif_functions, on_load, on_reload, on_upgrade, on_unload);
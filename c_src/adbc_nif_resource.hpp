@@ -8,6 +8,8 @@
 #include <type_traits>
 #include "nif_utils.hpp"
 #include "adbc_arrow_array_stream_record.hpp"
+#include "adbc_statement_params.hpp"
+#include "adbc_arrow_array_stream_queue.hpp"
 
 // Only for debugging:
 #include <cstdio>
@@ -113,9 +115,19 @@ static void destruct_adbc_connection_resource(ErlNifEnv *env, void *args) {
 
 static void destruct_adbc_statement_resource(ErlNifEnv *env, void *args) {
   auto res = (NifRes<struct AdbcStatement> *)args;
-  struct AdbcError adbc_error{};
-  if(res->private_data != nullptr) enif_release_resource(&res->private_data);
-  AdbcStatementRelease(&res->val, &adbc_error);
+  // `adbc_statement_release` may have released it already
+  if (res->val.private_driver != nullptr) {
+    struct AdbcError adbc_error{};
+    AdbcStatementRelease(&res->val, &adbc_error);
+    if (adbc_error.release != nullptr) {
+      adbc_error.release(&adbc_error);
+    }
+  }
+  // the driver may still reference the parameters until it is released
+  if (res->private_data != nullptr) {
+    delete (AdbcStatementParams *)res->private_data;
+    res->private_data = nullptr;
+  }
 }
 
 static void destruct_adbc_error(ErlNifEnv *env, void *args) {
@@ -125,28 +137,41 @@ static void destruct_adbc_error(ErlNifEnv *env, void *args) {
   }
 }
 
+// the pool that deletes detached stream prefetchers, see adbc_nif.cpp
+static AdbcThreadPool * get_cleanup_pool();
+
 static void destruct_adbc_arrow_array_stream(ErlNifEnv *env, void *args) {
-  auto res = (NifRes<struct AdbcStatement> *)args;
+  auto res = (NifRes<struct ArrowArrayStream> *)args;
   if (res->private_data) {
-    auto schema = (struct ArrowSchema*)res->private_data;
-    if (schema->release) {
-      schema->release(schema);
+    auto private_data = (struct ArrowArrayStreamPrivateData *)res->private_data;
+    // the reader may be blocked in `get_next`, so it is not waited for here
+    if (private_data->prefetcher) {
+      ArrowArrayStreamPrefetcher::detach(private_data->prefetcher, get_cleanup_pool());
+    }
+    release_shared_arrow_decoder_plan(private_data->plan);
+    if (private_data->columns_env) {
+      enif_free_env(private_data->columns_env);
     }
-    enif_free(schema);
+    enif_free(private_data);
     res->private_data = nullptr;
   }
 }
 
 static void destruct_arrow_array_stream_record(ErlNifEnv *env, void *args) {
   auto res = (NifRes<struct ArrowArrayStreamRecord> *)args;
-  if (res->val.schema) {
+  if (res->val.schema && res->val.owns_schema) {
     if (res->val.schema->release) {
       res->val.schema->release(res->val.schema);
       res->val.schema->release = nullptr;
     }
     enif_free(res->val.schema);
-    res->val.schema = nullptr;
   }
+  res->val.schema = nullptr;
+  // the dictionary cached by the stream's plan is about to be released
+  if (res->val.plan_owner && res->val.values) {
+    res->val.plan_owner->dictionaries.evict(res->val.values->dictionary);
+  }
+  res->val.release_plan();
 
   if (res->val.values) {
     if (res->val.values->release) {
@@ -158,4 +183,13 @@ static void destruct_arrow_array_stream_record(ErlNifEnv *env, void *args) {
   }
 }
 
+static void destruct_arrow_array_stream_queue_producer(ErlNifEnv *env, void *args) {
+  auto res = (NifRes<struct ArrowArrayStreamQueueProducer> *)args;
+  if (res->val.queue) {
+    res->val.queue->finish(EPIPE, "the producer of the stream exited before finishing it");
+    res->val.queue->release();
+    res->val.queue = nullptr;
+  }
+}
+
 #endif /* ADBC_NIF_RESOURCE_HPP */
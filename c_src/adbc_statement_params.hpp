@@ -0,0 +1,325 @@
+#ifndef ADBC_STATEMENT_PARAMS_HPP
+#define ADBC_STATEMENT_PARAMS_HPP
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <erl_nif.h>
+#include <nanoarrow/nanoarrow.h>
+#include "adbc_consts.h"
+
+/// Parameter buffers owned by a statement and reused between binds of
+/// scalar parameters (integers, floats, binaries, booleans and nil),
+/// either a single row (`fill`) or many rows at once (`fill_rows`).
+///
+/// The driver gets shallow copies of `schema` and `array` whose release
+/// callbacks do nothing, so the buffers stay with the statement. There
+/// are two sets of them: the one given to the driver by the last bind
+/// and the one the next bind fills. Once the driver accepts the new set
+/// (`commit`), they swap roles, so buffers are only reset (keeping their
+/// capacity) or rebuilt once the driver no longer points to them.
+/// The statement must be released before the parameters are destroyed.
+struct AdbcStatementParams {
+    struct Buffers {
+        struct ArrowSchema schema{};
+        struct ArrowArray array{};
+        // the type of each parameter, empty if `schema` and `array` are not built
+        std::vector<enum ArrowType> types;
+        // set once `array` was fully validated with the current schema
+        bool validated = false;
+
+        // shallow copies given to the driver, see `export_to`
+        std::vector<struct ArrowSchema> exported_schemas;
+        std::vector<struct ArrowSchema *> exported_schema_children;
+        std::vector<struct ArrowArray> exported_arrays;
+        std::vector<struct ArrowArray *> exported_array_children;
+
+        ~Buffers() {
+            this->reset_schema();
+        }
+
+        void reset_schema() {
+            if (this->array.release) this->array.release(&this->array);
+            if (this->schema.release) this->schema.release(&this->schema);
+            this->types.clear();
+            this->validated = false;
+        }
+    };
+
+    Buffers buffers[2];
+    // index of the buffers given to the driver by the last bind, or -1
+    int bound = -1;
+
+    /// The buffers filled by the next `fill` or `fill_rows`
+    Buffers &filling() {
+        return this->buffers[this->bound == 0 ? 1 : 0];
+    }
+
+    /// Marks the buffers just filled as the ones held by the driver,
+    /// once it accepted them
+    void commit() {
+        this->bound = this->bound == 0 ? 1 : 0;
+    }
+
+    bool has_bound() const {
+        return this->bound != -1;
+    }
+
+    /// Returns the type a scalar parameter is bound as, or
+    /// `NANOARROW_TYPE_UNINITIALIZED` if it is not a scalar
+    /// handled here (for example, an `%Adbc.Column{}`).
+    static enum ArrowType param_type(ErlNifEnv *env, ERL_NIF_TERM term) {
+        ErlNifSInt64 i64;
+        double f64;
+        ErlNifBinary bytes;
+        if (enif_get_int64(env, term, &i64)) {
+            return NANOARROW_TYPE_INT64;
+        } else if (enif_get_double(env, term, &f64)) {
+            return NANOARROW_TYPE_DOUBLE;
+        } else if (enif_inspect_iolist_as_binary(env, term, &bytes)) {
+            return bytes.size > INT32_MAX ? NANOARROW_TYPE_LARGE_STRING : NANOARROW_TYPE_STRING;
+        } else if (enif_is_identical(term, kAtomTrue) || enif_is_identical(term, kAtomFalse)) {
+            return NANOARROW_TYPE_BOOL;
+        } else if (enif_is_identical(term, kAtomNil)) {
+            return NANOARROW_TYPE_NA;
+        }
+        return NANOARROW_TYPE_UNINITIALIZED;
+    }
+
+    /// Fills the buffers with `values`, a list of `n_items` scalar parameters,
+    /// rebuilding the schema only if the parameter types changed.
+    /// @return 0 if success, -1 if `values` has parameters not handled here,
+    /// or a nanoarrow error code if failed with `error_out` set
+    int fill(ErlNifEnv *env, ERL_NIF_TERM values, unsigned n_items, struct ArrowError * error_out) {
+        std::vector<enum ArrowType> types(n_items);
+        ERL_NIF_TERM head, tail = values;
+        for (unsigned i = 0; enif_get_list_cell(env, tail, &head, &tail); i++) {
+            types[i] = AdbcStatementParams::param_type(env, head);
+            if (types[i] == NANOARROW_TYPE_UNINITIALIZED) {
+                return -1;
+            }
+        }
+
+        int code = this->start(types, error_out);
+        tail = values;
+        for (size_t i = 0; code == NANOARROW_OK && enif_get_list_cell(env, tail, &head, &tail); i++) {
+            code = this->append_value(env, i, head, error_out);
+        }
+        return this->finish(code, 1, error_out);
+    }
+
+    /// Fills the buffers with `rows`, a list of `n_rows` tuples or lists
+    /// of scalar parameters, one row per element of the bound array.
+    /// The type of each column is inferred from its first non-nil value.
+    /// @return 0 if success, or a nanoarrow error code with `error_out` set
+    int fill_rows(ErlNifEnv *env, ERL_NIF_TERM rows, unsigned n_rows, struct ArrowError * error_out) {
+        std::vector<ERL_NIF_TERM> row;
+        ERL_NIF_TERM head, tail = rows;
+        if (n_rows == 0 || !enif_get_list_cell(env, tail, &head, &tail) || get_row(env, head, row) != 0) {
+            snprintf(error_out->message, sizeof(error_out->message), "Expected a non-empty list of tuples or lists.");
+            return EINVAL;
+        }
+
+        size_t n_columns = row.size();
+        size_t typed = 0;
+        std::vector<enum ArrowType> types(n_columns, NANOARROW_TYPE_NA);
+        for (tail = rows; typed < n_columns && enif_get_list_cell(env, tail, &head, &tail);) {
+            if (get_row(env, head, row) != 0 || row.size() != n_columns) {
+                break;
+            }
+            for (size_t i = 0; i < n_columns; i++) {
+                if (types[i] != NANOARROW_TYPE_NA || enif_is_identical(row[i], kAtomNil)) {
+                    continue;
+                }
+                types[i] = AdbcStatementParams::param_type(env, row[i]);
+                if (types[i] == NANOARROW_TYPE_UNINITIALIZED) {
+                    enif_snprintf(error_out->message, sizeof(error_out->message), "unsupported parameter `%T`.", row[i]);
+                    return EINVAL;
+                }
+                typed++;
+            }
+        }
+
+        int code = this->start(types, error_out);
+        for (tail = rows; code == NANOARROW_OK && enif_get_list_cell(env, tail, &head, &tail);) {
+            if (get_row(env, head, row) != 0 || row.size() != n_columns) {
+                enif_snprintf(error_out->message, sizeof(error_out->message), "Expected all rows to be tuples or lists of %u parameters, got: `%T`.", (unsigned)n_columns, head);
+                code = EINVAL;
+                break;
+            }
+            for (size_t i = 0; code == NANOARROW_OK && i < n_columns; i++) {
+                code = this->append_value(env, i, row[i], error_out);
+            }
+        }
+        return this->finish(code, n_rows, error_out);
+    }
+
+    /// Gives the driver shallow copies of the parameters just filled,
+    /// valid until the fill after the next one, or until the parameters
+    /// are destroyed.
+    void export_to(struct ArrowArray * array_out, struct ArrowSchema * schema_out) {
+        AdbcStatementParams::export_buffers(this->filling(), array_out, schema_out);
+    }
+
+    /// Gives the driver shallow copies of the parameters of the last
+    /// bind again, after it rejected the new ones.
+    /// @return false if there were none
+    bool export_bound_to(struct ArrowArray * array_out, struct ArrowSchema * schema_out) {
+        if (!this->has_bound()) return false;
+        AdbcStatementParams::export_buffers(this->buffers[this->bound], array_out, schema_out);
+        return true;
+    }
+
+private:
+    static void export_buffers(Buffers &buffers, struct ArrowArray * array_out, struct ArrowSchema * schema_out) {
+        auto n_children = static_cast<size_t>(buffers.array.n_children);
+        buffers.exported_schemas.resize(n_children);
+        buffers.exported_schema_children.resize(n_children);
+        buffers.exported_arrays.resize(n_children);
+        buffers.exported_array_children.resize(n_children);
+
+        for (size_t i = 0; i < n_children; i++) {
+            buffers.exported_schemas[i] = *buffers.schema.children[i];
+            buffers.exported_schemas[i].release = AdbcStatementParams::release_schema;
+            buffers.exported_schema_children[i] = &buffers.exported_schemas[i];
+            buffers.exported_arrays[i] = *buffers.array.children[i];
+            buffers.exported_arrays[i].release = AdbcStatementParams::release_array;
+            buffers.exported_array_children[i] = &buffers.exported_arrays[i];
+        }
+
+        *schema_out = buffers.schema;
+        schema_out->children = buffers.exported_schema_children.data();
+        schema_out->release = AdbcStatementParams::release_schema;
+        *array_out = buffers.array;
+        array_out->children = buffers.exported_array_children.data();
+        array_out->release = AdbcStatementParams::release_array;
+    }
+
+    static int init_schema(Buffers &buffers, const std::vector<enum ArrowType> &types, struct ArrowError * error_out) {
+        ArrowSchemaInit(&buffers.schema);
+        NANOARROW_RETURN_NOT_OK(ArrowSchemaSetTypeStruct(&buffers.schema, static_cast<int64_t>(types.size())));
+        for (size_t i = 0; i < types.size(); i++) {
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetType(buffers.schema.children[i], types[i]));
+            NANOARROW_RETURN_NOT_OK(ArrowSchemaSetName(buffers.schema.children[i], ""));
+        }
+        return ArrowArrayInitFromSchema(&buffers.array, &buffers.schema, error_out);
+    }
+
+    /// Makes the buffers not held by the driver ready to be appended to,
+    /// keeping them if `types` are the same as in the fill that built them
+    int start(std::vector<enum ArrowType> &types, struct ArrowError * error_out) {
+        Buffers &buffers = this->filling();
+        if (types != buffers.types) {
+            buffers.reset_schema();
+            NANOARROW_RETURN_NOT_OK(AdbcStatementParams::init_schema(buffers, types, error_out));
+            buffers.types = std::move(types);
+        } else {
+            AdbcStatementParams::reset_buffers(&buffers.array);
+        }
+        return ArrowArrayStartAppending(&buffers.array);
+    }
+
+    /// Finishes the buffers being filled. If failed, they are released,
+    /// while the ones held by the driver are left untouched.
+    int finish(int code, int64_t length, struct ArrowError * error_out) {
+        Buffers &buffers = this->filling();
+        if (code == NANOARROW_OK) {
+            // the values are appended by nanoarrow and valid by construction,
+            // so the array only needs to be validated against a new schema
+            buffers.array.length = length;
+            auto level = buffers.validated ? NANOARROW_VALIDATION_LEVEL_NONE : NANOARROW_VALIDATION_LEVEL_FULL;
+            code = ArrowArrayFinishBuilding(&buffers.array, level, error_out);
+        }
+        if (code != NANOARROW_OK) {
+            buffers.reset_schema();
+            return code;
+        }
+        buffers.validated = true;
+        return 0;
+    }
+
+    int append_value(ErlNifEnv *env, size_t index, ERL_NIF_TERM term, struct ArrowError * error_out) {
+        Buffers &buffers = this->filling();
+        auto child = buffers.array.children[index];
+        if (enif_is_identical(term, kAtomNil)) {
+            return ArrowArrayAppendNull(child, 1);
+        }
+
+        ErlNifSInt64 i64;
+        double f64;
+        ErlNifBinary bytes;
+        switch (buffers.types[index]) {
+            case NANOARROW_TYPE_INT64:
+                if (!enif_get_int64(env, term, &i64)) break;
+                return ArrowArrayAppendInt(child, i64);
+            case NANOARROW_TYPE_DOUBLE:
+                if (enif_get_int64(env, term, &i64)) {
+                    f64 = static_cast<double>(i64);
+                } else if (!enif_get_double(env, term, &f64)) {
+                    break;
+                }
+                return ArrowArrayAppendDouble(child, f64);
+            case NANOARROW_TYPE_STRING:
+            case NANOARROW_TYPE_LARGE_STRING: {
+                if (!enif_inspect_iolist_as_binary(env, term, &bytes)) break;
+                struct ArrowStringView view{};
+                view.data = (const char *)(bytes.data);
+                view.size_bytes = static_cast<int64_t>(bytes.size);
+                return ArrowArrayAppendString(child, view);
+            }
+            case NANOARROW_TYPE_BOOL:
+                if (enif_is_identical(term, kAtomTrue)) return ArrowArrayAppendInt(child, 1);
+                if (enif_is_identical(term, kAtomFalse)) return ArrowArrayAppendInt(child, 0);
+                break;
+            default:
+                break;
+        }
+
+        enif_snprintf(error_out->message, sizeof(error_out->message), "Expected all values of parameter %u to have the same type, got: `%T`.", (unsigned)index + 1, term);
+        return EINVAL;
+    }
+
+    static int get_row(ErlNifEnv *env, ERL_NIF_TERM term, std::vector<ERL_NIF_TERM> &row) {
+        int arity = 0;
+        const ERL_NIF_TERM * elements = nullptr;
+        if (enif_get_tuple(env, term, &arity, &elements)) {
+            row.assign(elements, elements + arity);
+            return 0;
+        }
+
+        row.clear();
+        ERL_NIF_TERM head, tail = term;
+        if (!enif_is_list(env, term)) {
+            return 1;
+        }
+        while (enif_get_list_cell(env, tail, &head, &tail)) {
+            row.push_back(head);
+        }
+        return 0;
+    }
+
+    /// Empties the buffers of `array` and its children, keeping their capacity
+    static void reset_buffers(struct ArrowArray * array) {
+        for (int64_t i = 0; i < array->n_children; i++) {
+            AdbcStatementParams::reset_buffers(array->children[i]);
+        }
+        for (int i = 0; i < NANOARROW_MAX_FIXED_BUFFERS; i++) {
+            ArrowArrayBuffer(array, i)->size_bytes = 0;
+        }
+        ArrowArrayValidityBitmap(array)->size_bits = 0;
+        array->length = 0;
+        array->null_count = 0;
+    }
+
+    static void release_schema(struct ArrowSchema * schema) {
+        schema->release = nullptr;
+    }
+
+    static void release_array(struct ArrowArray * array) {
+        array->release = nullptr;
+    }
+};
+
+#endif  // ADBC_STATEMENT_PARAMS_HPP
@@ -0,0 +1,121 @@
+#ifndef ADBC_THREAD_POOL_HPP
+#define ADBC_THREAD_POOL_HPP
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include <erl_nif.h>
+
+/// A fixed size pool of native threads running `std::function<void()>` tasks.
+///
+/// It only uses the thread primitives of the NIF API, so the threads are
+/// ordinary ERTS threads and need no extra link flags.
+struct AdbcThreadPool {
+    ErlNifMutex * mutex = nullptr;
+    ErlNifCond * cond = nullptr;
+    std::deque<std::function<void()>> tasks;
+    std::vector<ErlNifTid> threads;
+    bool stopping = false;
+    // the number of tasks being run by the workers
+    size_t running = 0;
+
+    /// Starts `n_threads` worker threads
+    /// @return 0 if success, 1 if failed
+    int start(const char * name, int n_threads) {
+        this->mutex = enif_mutex_create((char *)"adbc_thread_pool_mutex");
+        this->cond = enif_cond_create((char *)"adbc_thread_pool_cond");
+        if (this->mutex == nullptr || this->cond == nullptr) {
+            this->stop();
+            return 1;
+        }
+
+        for (int i = 0; i < n_threads; i++) {
+            ErlNifTid tid;
+            if (enif_thread_create((char *)name, &tid, AdbcThreadPool::run, this, nullptr) != 0) {
+                this->stop();
+                return 1;
+            }
+            this->threads.emplace_back(tid);
+        }
+        return 0;
+    }
+
+    /// Queues `task` to be run by one of the worker threads
+    void submit(std::function<void()> task) {
+        enif_mutex_lock(this->mutex);
+        this->tasks.emplace_back(std::move(task));
+        enif_cond_signal(this->cond);
+        enif_mutex_unlock(this->mutex);
+    }
+
+    /// Lets the workers finish the queued tasks and joins them
+    void stop() {
+        if (this->mutex != nullptr && this->cond != nullptr) {
+            enif_mutex_lock(this->mutex);
+            this->stopping = true;
+            enif_cond_broadcast(this->cond);
+            enif_mutex_unlock(this->mutex);
+
+            for (auto &tid : this->threads) {
+                enif_thread_join(tid, nullptr);
+            }
+        }
+        this->threads.clear();
+
+        if (this->cond) {
+            enif_cond_destroy(this->cond);
+            this->cond = nullptr;
+        }
+        if (this->mutex) {
+            enif_mutex_destroy(this->mutex);
+            this->mutex = nullptr;
+        }
+    }
+
+    /// Makes the workers exit once the queued tasks are done and joins them
+    /// only if none of them is running a task, since a task may be blocked
+    /// in a driver call for as long as the driver takes. Otherwise, the
+    /// workers are left to exit on their own and the pool must be leaked.
+    /// @return true if the workers were joined and the pool can be deleted
+    bool shutdown() {
+        if (this->mutex != nullptr) {
+            enif_mutex_lock(this->mutex);
+            bool busy = this->running > 0 || !this->tasks.empty();
+            this->stopping = true;
+            enif_cond_broadcast(this->cond);
+            enif_mutex_unlock(this->mutex);
+            if (busy) {
+                return false;
+            }
+        }
+        this->stop();
+        return true;
+    }
+
+    static void * run(void * arg) {
+        auto pool = (AdbcThreadPool *)arg;
+        while (true) {
+            enif_mutex_lock(pool->mutex);
+            while (pool->tasks.empty() && !pool->stopping) {
+                enif_cond_wait(pool->cond, pool->mutex);
+            }
+            if (pool->tasks.empty()) {
+                enif_mutex_unlock(pool->mutex);
+                return nullptr;
+            }
+            auto task = std::move(pool->tasks.front());
+            pool->tasks.pop_front();
+            pool->running++;
+            enif_mutex_unlock(pool->mutex);
+
+            task();
+
+            enif_mutex_lock(pool->mutex);
+            pool->running--;
+            enif_mutex_unlock(pool->mutex);
+        }
+    }
+};
+
+#endif  // ADBC_THREAD_POOL_HPP
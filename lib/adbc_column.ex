@@ -4,6 +4,27 @@ defmodule Adbc.Column do
 
   `Adbc.Column` corresponds to a column in the table. It contains the column's name, type, and
   data. The data is a list of values of the column's data type.
+
+  ## Packed data
+
+  Integer, floating point, date, time, timestamp and duration columns can
+  also be built from a binary with the values packed in Arrow's
+  little-endian layout, such as the ones returned by `Nx.to_binary/1`,
+  `Explorer.Series.to_binary/1` or `to_binary/1`:
+
+      Adbc.Column.s32(<<1::32-signed-little, 2::32-signed-little>>)
+
+  Null values are given with the `:validity` option, an Arrow validity
+  bitmap with one bit per value, least significant bit first, where `1`
+  means the value is valid. Giving a validity bitmap makes the column
+  nullable:
+
+      Adbc.Column.f64(<<1.0::float-64-little, 0.0::float-64-little>>, validity: <<0b01>>)
+
+  Packed columns are passed to the database without any per-value
+  conversion: the Arrow buffers point straight at the binaries, except
+  for sub-binaries whose values are not aligned in memory, which are
+  copied. They cannot be used as the items of list columns.
   """
   @enforce_keys [:name, :type, :nullable]
   defstruct [:name, :type, :nullable, :metadata, :data, :length, :offset]
@@ -45,6 +66,7 @@ defmodule Adbc.Column do
           | :milliseconds
           | :microseconds
           | :nanoseconds
+  @time_units [:seconds, :milliseconds, :microseconds, :nanoseconds]
   @type time32 ::
           {:time32, :seconds}
           | {:time32, :milliseconds}
@@ -179,7 +201,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of unsigned 8-bit integer values
+  * `data`: A list of unsigned 8-bit integer values, or a binary of packed 8-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -187,6 +209,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -200,8 +223,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec u8([u8() | nil], Keyword.t()) :: t()
-  def u8(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec u8([u8() | nil] | binary(), Keyword.t()) :: t()
+  def u8(data, opts \\ [])
+
+  def u8(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :u8, 1, opts)
+  end
+
+  def u8(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :u8,
@@ -216,7 +245,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of unsigned 16-bit integer values
+  * `data`: A list of unsigned 16-bit integer values, or a binary of packed 16-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -224,6 +253,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -237,8 +267,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec u16([u16() | nil], Keyword.t()) :: t()
-  def u16(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec u16([u16() | nil] | binary(), Keyword.t()) :: t()
+  def u16(data, opts \\ [])
+
+  def u16(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :u16, 2, opts)
+  end
+
+  def u16(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :u16,
@@ -253,7 +289,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of un32-bit signed integer values
+  * `data`: A list of un32-bit signed integer values, or a binary of packed 32-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -261,6 +297,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -274,8 +311,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec u32([u32() | nil], Keyword.t()) :: t()
-  def u32(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec u32([u32() | nil] | binary(), Keyword.t()) :: t()
+  def u32(data, opts \\ [])
+
+  def u32(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :u32, 4, opts)
+  end
+
+  def u32(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :u32,
@@ -290,7 +333,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of un64-bit signed integer values
+  * `data`: A list of un64-bit signed integer values, or a binary of packed 64-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -298,6 +341,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -311,8 +355,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec u64([u64() | nil], Keyword.t()) :: t()
-  def u64(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec u64([u64() | nil] | binary(), Keyword.t()) :: t()
+  def u64(data, opts \\ [])
+
+  def u64(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :u64, 8, opts)
+  end
+
+  def u64(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :u64,
@@ -327,7 +377,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of signed 8-bit integer values
+  * `data`: A list of signed 8-bit integer values, or a binary of packed 8-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -335,6 +385,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -348,8 +399,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec s8([s8() | nil], Keyword.t()) :: t()
-  def s8(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec s8([s8() | nil] | binary(), Keyword.t()) :: t()
+  def s8(data, opts \\ [])
+
+  def s8(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :s8, 1, opts)
+  end
+
+  def s8(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :s8,
@@ -364,7 +421,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of signed 16-bit integer values
+  * `data`: A list of signed 16-bit integer values, or a binary of packed 16-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -372,6 +429,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -385,8 +443,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec s16([s16() | nil], Keyword.t()) :: t()
-  def s16(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec s16([s16() | nil] | binary(), Keyword.t()) :: t()
+  def s16(data, opts \\ [])
+
+  def s16(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :s16, 2, opts)
+  end
+
+  def s16(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :s16,
@@ -401,7 +465,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of 32-bit signed integer values
+  * `data`: A list of 32-bit signed integer values, or a binary of packed 32-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -409,6 +473,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -422,8 +487,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec s32([s32() | nil], Keyword.t()) :: t()
-  def s32(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec s32([s32() | nil] | binary(), Keyword.t()) :: t()
+  def s32(data, opts \\ [])
+
+  def s32(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :s32, 4, opts)
+  end
+
+  def s32(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :s32,
@@ -438,7 +509,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of 64-bit signed integer values
+  * `data`: A list of 64-bit signed integer values, or a binary of packed 64-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -446,6 +517,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -459,8 +531,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec s64([s64() | nil], Keyword.t()) :: t()
-  def s64(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec s64([s64() | nil] | binary(), Keyword.t()) :: t()
+  def s64(data, opts \\ [])
+
+  def s64(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :s64, 8, opts)
+  end
+
+  def s64(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :s64,
@@ -475,7 +553,8 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of 32-bit single-precision float values (will be converted to 16-bit floats in C)
+  * `data`: A list of 32-bit single-precision float values (will be converted to 16-bit floats in C),
+    or a binary of packed 16-bit half-precision float values
   * `opts`: A keyword list of options
 
   ## Options
@@ -483,6 +562,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -496,8 +576,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec f16([float | nil | :infinity | :neg_infinity | :nan], Keyword.t()) :: t()
-  def f16(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec f16([float | nil | :infinity | :neg_infinity | :nan] | binary(), Keyword.t()) :: t()
+  def f16(data, opts \\ [])
+
+  def f16(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :f16, 2, opts)
+  end
+
+  def f16(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :f16,
@@ -512,7 +598,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of 32-bit single-precision float values
+  * `data`: A list of 32-bit single-precision float values, or a binary of packed 32-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -520,6 +606,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -533,8 +620,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec f32([float | nil | :infinity | :neg_infinity | :nan], Keyword.t()) :: t()
-  def f32(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec f32([float | nil | :infinity | :neg_infinity | :nan] | binary(), Keyword.t()) :: t()
+  def f32(data, opts \\ [])
+
+  def f32(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :f32, 4, opts)
+  end
+
+  def f32(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :f32,
@@ -549,7 +642,7 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: A list of 64-bit double-precision float values
+  * `data`: A list of 64-bit double-precision float values, or a binary of packed 64-bit values
   * `opts`: A keyword list of options
 
   ## Options
@@ -557,6 +650,7 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
 
   ## Examples
 
@@ -570,8 +664,14 @@ defmodule Adbc.Column do
       }
 
   """
-  @spec f64([float | nil | :infinity | :neg_infinity | :nan], Keyword.t()) :: t()
-  def f64(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec f64([float | nil | :infinity | :neg_infinity | :nan] | binary(), Keyword.t()) :: t()
+  def f64(data, opts \\ [])
+
+  def f64(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :f64, 8, opts)
+  end
+
+  def f64(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :f64,
@@ -900,6 +1000,8 @@ defmodule Adbc.Column do
   * `data`: a list, each element of which can be one of the following:
     * a `Date.t()`
     * a 32-bit signed integer representing the number of days since the Unix epoch.
+
+    or a binary of packed 32-bit values.
   * `opts`: A keyword list of options
 
   ## Options
@@ -907,9 +1009,16 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
   """
-  @spec date32([Date.t() | s32() | nil], Keyword.t()) :: t()
-  def date32(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec date32([Date.t() | s32() | nil] | binary(), Keyword.t()) :: t()
+  def date32(data, opts \\ [])
+
+  def date32(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :date32, 4, opts)
+  end
+
+  def date32(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :date32,
@@ -926,6 +1035,8 @@ defmodule Adbc.Column do
   * `data`: a list, each element of which can be one of the following:
     * a `Date.t()`
     * a 64-bit signed integer representing the number of milliseconds since the Unix epoch.
+
+    or a binary of packed 64-bit values.
   * `opts`: A keyword list of options
 
   ## Options
@@ -933,9 +1044,16 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
   """
-  @spec date64([Date.t() | s64() | nil], Keyword.t()) :: t()
-  def date64(data, opts \\ []) when is_list(data) and is_list(opts) do
+  @spec date64([Date.t() | s64() | nil] | binary(), Keyword.t()) :: t()
+  def date64(data, opts \\ [])
+
+  def date64(data, opts) when is_binary(data) and is_list(opts) do
+    packed(data, :date64, 8, opts)
+  end
+
+  def date64(data, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
       type: :date64,
@@ -958,6 +1076,9 @@ defmodule Adbc.Column do
 
       For `:microseconds` and `:nanoseconds`, the time value is limited to the range of 64-bit signed integers.
 
+    * a binary of packed 32-bit values for `:seconds` and `:milliseconds`,
+      or 64-bit values for `:microseconds` and `:nanoseconds`
+
   * `unit`: specify the unit of the time value, one of the following:
     * `:seconds`
     * `:milliseconds`
@@ -971,10 +1092,21 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
   """
-  @spec time([Time.t() | nil] | [s64() | nil], time_unit(), Keyword.t()) :: t()
+  @spec time([Time.t() | nil] | [s64() | nil] | binary(), time_unit(), Keyword.t()) :: t()
   def time(data, unit, opts \\ [])
 
+  def time(data, unit, opts)
+      when is_binary(data) and unit in [:seconds, :milliseconds] and is_list(opts) do
+    packed(data, {:time32, unit}, 4, opts)
+  end
+
+  def time(data, unit, opts)
+      when is_binary(data) and unit in [:microseconds, :nanoseconds] and is_list(opts) do
+    packed(data, {:time64, unit}, 8, opts)
+  end
+
   def time(data, :seconds, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
@@ -1023,6 +1155,7 @@ defmodule Adbc.Column do
   * `data`:
     * a list of `NaiveDateTime.t()` value
     * a list of 64-bit signed integer values representing the time in the specified unit
+    * a binary of packed 64-bit values
 
   * `unit`: specify the unit of the time value, one of the following:
     * `:seconds`
@@ -1039,11 +1172,21 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
   """
-  @spec timestamp([NaiveDateTime.t() | nil] | [s64() | nil], time_unit(), String.t(), Keyword.t()) ::
-          t()
+  @spec timestamp(
+          [NaiveDateTime.t() | nil] | [s64() | nil] | binary(),
+          time_unit(),
+          String.t(),
+          Keyword.t()
+        ) :: t()
   def timestamp(data, unit, timezone, opts \\ [])
 
+  def timestamp(data, unit, timezone, opts)
+      when is_binary(data) and unit in @time_units and is_binary(timezone) and is_list(opts) do
+    packed(data, {:timestamp, unit, timezone}, 8, opts)
+  end
+
   def timestamp(data, :seconds, timezone, opts)
       when is_list(data) and is_binary(timezone) and is_list(opts) do
     %Adbc.Column{
@@ -1093,7 +1236,8 @@ defmodule Adbc.Column do
 
   ## Arguments
 
-  * `data`: a list of integer values representing the time in the specified unit
+  * `data`: a list of integer values representing the time in the specified unit,
+    or a binary of packed 64-bit values
 
   * `unit`: specify the unit of the time value, one of the following:
     * `:seconds`
@@ -1108,10 +1252,15 @@ defmodule Adbc.Column do
   * `:name` - The name of the column
   * `:nullable` - A boolean value indicating whether the column is nullable
   * `:metadata` - A map of metadata
+  * `:validity` - The validity bitmap of packed `data`, see the "Packed data" section in the module documentation
   """
-  @spec duration([s64() | nil], time_unit(), Keyword.t()) :: t()
+  @spec duration([s64() | nil] | binary(), time_unit(), Keyword.t()) :: t()
   def duration(data, unit, opts \\ [])
 
+  def duration(data, unit, opts) when is_binary(data) and unit in @time_units and is_list(opts) do
+    packed(data, {:duration, unit}, 8, opts)
+  end
+
   def duration(data, :seconds, opts) when is_list(data) and is_list(opts) do
     %Adbc.Column{
       name: opts[:name],
@@ -1369,68 +1518,292 @@ defmodule Adbc.Column do
     }
   end
 
+  # Builds a run-end encoded column from its `run_ends` (`:s16`, `:s32` or
+  # `:s64`) and `values` columns. The `:offset` and `:length` options give
+  # the logical rows, by default all of them. Only used by the tests for now.
+  @doc false
+  @spec run_end_encoded(t(), t(), Keyword.t()) :: t()
+  def run_end_encoded(
+        run_ends = %Adbc.Column{type: run_end_type, data: data},
+        values = %Adbc.Column{},
+        opts \\ []
+      )
+      when run_end_type in @valid_run_end_types and is_list(data) do
+    offset = opts[:offset] || 0
+
+    %Adbc.Column{
+      name: opts[:name],
+      type: :run_end_encoded,
+      nullable: opts[:nullable] || false,
+      metadata: opts[:metadata] || nil,
+      data: %{run_ends: run_ends, values: values},
+      length: opts[:length] || List.last(data, offset) - offset,
+      offset: offset
+    }
+  end
+
   @doc """
-  `materialize/1` converts a column's data from reference type to regular Elixir terms.
+  `materialize/2` converts a column's data from reference type to regular Elixir terms.
+
+  ## Options
+
+    * `:zero_copy` - when `true`, string and binary values (including fixed
+      size binaries) are returned as sub-binaries of the underlying Arrow data
+      buffer instead of being copied one by one. This makes materializing large
+      text columns much cheaper, but the whole Arrow buffer is kept in memory
+      for as long as any of the returned values is referenced. Use
+      `:binary.copy/1` on values that outlive the column. Defaults to `false`.
+
+    * `:decode_dictionary` - when `true`, dictionary-encoded columns are
+      materialized into the values their indices refer to, with the type of
+      the dictionary values, instead of `%{key: keys, value: dictionary}`.
+      The dictionary is decoded once and the indices are looked up natively.
+      Dictionaries shared by the batches of a result are decoded only once
+      per result. Defaults to `false`.
+
+    * `:run_end_encoded` - how run-end encoded columns are materialized:
+
+      * `:columns` - as `%{run_ends: column, values: column}` (the default)
+
+      * `:decode` - into the value of every row, with the type of the values.
+        Runs are expanded natively, so this is much cheaper than calling
+        `to_list/1` on the columns
+
+      * `:packed` - as `%{run_ends: binary, values: list}`, with the values of
+        the runs covering the column and their ends as little-endian 64-bit
+        integers, relative to the first row of the column and clamped to its
+        length. The runs of all batches are merged into one, joining a run
+        that continues from one batch into the next
+
+      Columns whose values are structs, maps, unions or other encoded types
+      are always materialized as `:columns`.
+
+    * `:plain_lists` - when `true`, each list of list, large list and fixed
+      size list columns is materialized as a plain list of its items instead
+      of an `%Adbc.Column{}`, and the column keeps its `{:list, item}` type.
+      Lists of structs, maps, unions or encoded types are still columns.
+      Defaults to `false`.
+
   """
-  @spec materialize(t()) ::
+  @spec materialize(t(), Keyword.t()) ::
           t() | {:error, String.t()}
-  def materialize(%Adbc.Column{data: data_ref} = self)
+  def materialize(column, opts \\ [])
+
+  def materialize(%Adbc.Column{data: data_ref} = self, opts)
       when is_reference(data_ref) or is_list(data_ref) do
+    opts = validate_materialize_opts!(opts)
+
     if is_list(data_ref) do
       if Enum.all?(data_ref, &is_reference/1) do
-        do_materialize(self)
+        do_materialize(self, opts)
       else
         self
       end
     else
-      do_materialize(self)
+      do_materialize(self, opts)
     end
   end
 
-  def materialize(%Adbc.Column{} = self) do
+  def materialize(%Adbc.Column{} = self, _opts) do
     self
   end
 
-  defp do_materialize(%Adbc.Column{data: data_ref, type: type} = self) do
-    with {:ok, results} <- Adbc.Nif.adbc_column_materialize(data_ref) do
-      materialized =
-        Enum.reduce(results, [], fn result, acc ->
-          acc ++ result
-        end)
+  defp do_materialize(%Adbc.Column{data: data_ref} = self, opts) do
+    with {:ok, materialized} <- nif_materialize(data_ref, opts) do
+      put_materialized(self, materialized, opts)
+    end
+  end
+
+  defp put_materialized(%Adbc.Column{type: type} = self, materialized, opts) do
+    type =
+      case type do
+        {:list, _} ->
+          if opts[:plain_lists], do: type, else: :list
 
-      type =
-        case type do
-          {:list, _} ->
-            :list
+        {:dictionary, value_type} ->
+          if opts[:decode_dictionary], do: value_type, else: type
 
-          _ ->
+        {:run_end_encoded, %{values: %Adbc.Column{type: value_type}}} ->
+          # values that cannot be expanded are kept as columns
+          if opts[:run_end_encoded] == :decode and is_list(materialized) do
+            value_type
+          else
             type
+          end
+
+        _ ->
+          type
+      end
+
+    %{self | data: materialized, type: type}
+  end
+
+  # Materializes all the unmaterialized columns of a result concurrently
+  # on the native workers, see `Adbc.Result.materialize/2`
+  @doc false
+  def materialize_many(columns, opts) do
+    opts = validate_materialize_opts!(opts)
+
+    case Enum.filter(columns, &unmaterialized?/1) do
+      pending when length(pending) < 2 ->
+        materialize_each(columns, opts)
+
+      pending ->
+        workers =
+          Application.get_env(
+            :adbc,
+            :materialize_workers,
+            :erlang.system_info(:dirty_cpu_schedulers)
+          )
+
+        nif_opts = opts |> nif_materialize_opts() |> Map.put(:workers, workers)
+        data_refs = Enum.map(pending, & &1.data)
+        ref = make_ref()
+
+        with :ok <- Adbc.Nif.adbc_columns_materialize(data_refs, nif_opts, ref),
+             {:ok, results} <- await_materialized(ref) do
+          {columns, []} =
+            Enum.map_reduce(columns, results, fn column, results ->
+              if unmaterialized?(column) do
+                [materialized | results] = results
+                {put_materialized(column, materialized, opts), results}
+              else
+                {column, results}
+              end
+            end)
+
+          {:ok, columns}
         end
+    end
+  end
 
-      handle_decimal(%{self | data: materialized, type: type})
+  # the workers reply once all the batches are decoded
+  defp await_materialized(ref) do
+    receive do
+      {^ref, result} -> result
     end
   end
 
-  defp handle_decimal(%Adbc.Column{type: {:decimal, bits, _, scale}, data: decimal_data} = column) do
-    %{column | data: handle_decimal(decimal_data, bits, scale)}
+  # Materializes the columns one after the other, stopping at the first error
+  @doc false
+  def materialize_each(columns, opts) do
+    opts = validate_materialize_opts!(opts)
+
+    columns
+    |> Enum.reduce_while({:ok, []}, fn column, {:ok, acc} ->
+      case materialize(column, opts) do
+        {:error, _} = error -> {:halt, error}
+        column -> {:cont, {:ok, [column | acc]}}
+      end
+    end)
+    |> case do
+      {:ok, acc} -> {:ok, Enum.reverse(acc)}
+      error -> error
+    end
   end
 
-  defp handle_decimal(column) do
-    column
+  defp validate_materialize_opts!(opts) do
+    opts =
+      Keyword.validate!(opts,
+        zero_copy: false,
+        decode_dictionary: false,
+        run_end_encoded: :columns,
+        plain_lists: false
+      )
+
+    unless opts[:run_end_encoded] in [:columns, :decode, :packed] do
+      raise ArgumentError,
+            "expected :run_end_encoded to be one of :columns, :decode or :packed, " <>
+              "got: #{inspect(opts[:run_end_encoded])}"
+    end
+
+    opts
   end
 
-  defp handle_decimal(decimal_data, bits, scale) do
-    Enum.map(decimal_data, fn
-      <<decimal::signed-integer-size(bits)-little>> ->
-        if decimal < 0 do
-          Decimal.new(-1, -decimal, -scale)
-        else
-          Decimal.new(1, decimal, -scale)
-        end
+  defp unmaterialized?(%Adbc.Column{data: data_ref}) do
+    is_reference(data_ref) or (is_list(data_ref) and Enum.all?(data_ref, &is_reference/1))
+  end
 
-      nil ->
-        nil
-    end)
+  defp nif_materialize(data_ref, opts) do
+    Adbc.Nif.adbc_column_materialize(data_ref, nif_materialize_opts(opts))
+  end
+
+  defp nif_materialize_opts(opts) do
+    Map.new(Keyword.take(opts, [:zero_copy, :decode_dictionary, :run_end_encoded, :plain_lists]))
+  end
+
+  @doc """
+  Returns the data of an unmaterialized column of a fixed width type
+  as a packed binary, along with its validity bitmap.
+
+  This is useful to hand query results over to libraries that work with
+  packed binaries, such as Nx or Explorer, without building an Elixir
+  list first.
+
+  It returns `{data, validity}`, where `data` holds the values of the column
+  in Arrow's little-endian layout and `validity` is the Arrow validity bitmap
+  (one bit per value, least significant bit first, `1` means valid), or `nil`
+  when the column has no null values. The values of null entries in `data`
+  are undefined.
+
+  When the column consists of a single batch, `data` refers to the Arrow
+  buffer directly and keeps the whole batch in memory while it is
+  referenced. Multiple batches are concatenated into a new binary.
+
+  Integer, floating point, temporal, interval, decimal and fixed size
+  binary columns are supported. Raises `ArgumentError` for other types.
+
+  ## Examples
+
+      {:ok, result} = Adbc.Connection.query(conn, "SELECT * FROM measurements")
+      column = Enum.find(result.data, &(&1.name == "value"))
+      {data, nil} = Adbc.Column.to_binary(column)
+      Nx.from_binary(data, :f64)
+
+  """
+  @spec to_binary(t()) :: {binary(), binary() | nil}
+  def to_binary(%Adbc.Column{data: data_ref}) when is_reference(data_ref) or is_list(data_ref) do
+    if is_list(data_ref) and not Enum.all?(data_ref, &is_reference/1) do
+      raise ArgumentError, "to_binary/1 expects an unmaterialized column"
+    end
+
+    case Adbc.Nif.adbc_column_to_binary(data_ref) do
+      {:ok, {data, validity}} -> {data, validity}
+      {:error, reason} -> raise ArgumentError, reason
+    end
+  end
+
+  def to_binary(%Adbc.Column{}) do
+    raise ArgumentError, "to_binary/1 expects an unmaterialized column"
+  end
+
+  defp packed(data, type, nbytes, opts) do
+    opts = Keyword.validate!(opts, [:name, :nullable, :metadata, :validity])
+    validity = opts[:validity]
+
+    if rem(byte_size(data), nbytes) != 0 do
+      raise ArgumentError,
+            "expected the packed data of a #{inspect(type)} column to have a size " <>
+              "that is a multiple of #{nbytes} bytes, got: #{byte_size(data)} bytes"
+    end
+
+    length = div(byte_size(data), nbytes)
+
+    if validity != nil and
+         (not is_binary(validity) or byte_size(validity) < div(length + 7, 8)) do
+      raise ArgumentError,
+            "expected :validity to be a binary of at least #{div(length + 7, 8)} bytes " <>
+              "for #{length} values, got: #{inspect(validity)}"
+    end
+
+    %Adbc.Column{
+      name: opts[:name],
+      type: type,
+      nullable: opts[:nullable] || validity != nil,
+      metadata: opts[:metadata] || nil,
+      data: %{values: data, validity: validity},
+      length: length
+    }
   end
 
   @doc """
@@ -1497,6 +1870,7 @@ defmodule Adbc.Column do
       })
       when is_integer(offset) and offset >= 0 and is_integer(length) and length >= 1 do
     values = to_list(values)
+    values = if is_list(values), do: List.to_tuple(values), else: values
 
     max_allowed_length =
       case run_end_type do
@@ -1556,7 +1930,7 @@ defmodule Adbc.Column do
             {run_end, value_index + 1, List.duplicate(values, real_end - index) ++ acc}
           else
             {run_end, value_index + 1,
-             List.duplicate(Enum.at(values, value_index), real_end - index) ++ acc}
+             List.duplicate(elem(values, value_index), real_end - index) ++ acc}
           end
       end)
 
@@ -1564,11 +1938,11 @@ defmodule Adbc.Column do
   end
 
   def to_list(%Adbc.Column{data: %{key: key, value: value}, type: :dictionary}) do
-    value = to_list(value)
+    value = value |> to_list() |> List.to_tuple()
 
     Enum.map(key.data, fn
       index when is_integer(index) ->
-        Enum.at(value, index)
+        elem(value, index)
 
       nil ->
         nil
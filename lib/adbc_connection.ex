@@ -4,6 +4,17 @@ defmodule Adbc.Connection do
 
   Connection are modelled as processes. They require
   an `Adbc.Database` to be started.
+
+  Queries run on a pool of native threads, shared by all connections,
+  instead of the VM's dirty schedulers. The connection process waits
+  for the driver without blocking a scheduler. The pool has as many
+  threads as dirty IO schedulers by default, which can be changed with
+  `config :adbc, :executor_threads, count` before the first query.
+
+  Connection setup runs on a separate pool, so opening a connection
+  does not wait for slow queries. It has as many threads as dirty IO
+  schedulers by default, which can be changed with
+  `config :adbc, :setup_threads, count` before the first connection.
   """
 
   @type t :: GenServer.server()
@@ -22,6 +33,15 @@ defmodule Adbc.Connection do
     * `:process_options` - the options to be given to the underlying
       process. See `GenServer.start_link/3` for all options
 
+    * `:statement_cache_size` - the number of prepared statements kept
+      for queries given as strings, keyed by the query, its statement
+      options and whether it has parameters. The least recently used
+      statement is released once the limit is reached, and statements
+      whose query failed or was cancelled are not reused. Set it to `0`
+      to create a new statement for every query. Defaults to `16`
+
+  All other options are given as connection options to the underlying driver.
+
   ## Examples
 
       Adbc.Connection.start_link(
@@ -46,10 +66,16 @@ defmodule Adbc.Connection do
     end
 
     {process_options, opts} = Keyword.pop(opts, :process_options, [])
+    {cache_size, opts} = Keyword.pop(opts, :statement_cache_size, 16)
+
+    unless is_integer(cache_size) and cache_size >= 0 do
+      raise ArgumentError,
+            ":statement_cache_size must be a non-negative integer, got: #{inspect(cache_size)}"
+    end
 
     with {:ok, conn} <- Adbc.Nif.adbc_connection_new(),
          :ok <- init_options(conn, opts) do
-      GenServer.start_link(__MODULE__, {db, conn}, process_options)
+      GenServer.start_link(__MODULE__, {db, conn, cache_size}, process_options)
     else
       {:error, reason} -> {:error, error_to_exception(reason)}
     end
@@ -153,13 +179,54 @@ defmodule Adbc.Connection do
 
   @doc """
   Runs the given `query` with `params` and `statement_options`.
+
+  The record batches returned by the driver are concatenated natively,
+  so that every column of the result holds a single reference. The
+  following options, given together with `statement_options`, bound the
+  amount of data concatenated at once, in which case a column holds one
+  reference per chunk:
+
+    * `:coalesce_max_rows` - stop a chunk once it has at least this
+      many rows. Defaults to `nil` (unbounded)
+
+    * `:coalesce_max_bytes` - stop a chunk once its buffers take at
+      least this many bytes. Defaults to `nil` (unbounded)
+
+  Record batches are never split, so a chunk may go over both limits.
+
+  The driver can also be asked for the next batches while the previous
+  ones are being processed:
+
+    * `:prefetch` - the number of batches read ahead by a native
+      thread, so that the driver's I/O overlaps with the conversion of
+      the result. Mostly useful with network drivers. Defaults to `nil`
+      (batches are read on demand)
+
+  Finally, the query can be given a deadline:
+
+    * `:timeout` - the time in milliseconds the query and the reading
+      of its results may take, from the moment the query starts to run.
+      Once it expires the driver is asked to cancel the query, which
+      then returns an error. Defaults to `:infinity`
+
+  A query is also cancelled if the calling process exits while it runs.
   """
   @spec query(t(), binary | reference, [term], Keyword.t()) ::
           {:ok, result_set} | {:error, Exception.t()}
   def query(conn, query, params \\ [], statement_options \\ [])
       when (is_binary(query) or is_reference(query)) and is_list(params) and
              is_list(statement_options) do
-    stream(conn, {:query, query, params, statement_options}, &stream_results/3)
+    {coalesce, statement_options} =
+      Keyword.split(statement_options, [:coalesce_max_rows, :coalesce_max_bytes, :prefetch])
+
+    {timeout, statement_options} = Keyword.pop(statement_options, :timeout, :infinity)
+
+    stream(
+      conn,
+      {:query, query, params, statement_options},
+      fn conn, reference, num_rows -> stream_results(conn, reference, num_rows, coalesce) end,
+      timeout
+    )
   end
 
   @doc """
@@ -175,6 +242,49 @@ defmodule Adbc.Connection do
     end
   end
 
+  @doc """
+  Runs the given `query` once for each row in `rows` and returns
+  the total number of affected rows, as reported by the driver.
+
+  Each row is a tuple or a list with one value per parameter of
+  the query. All rows are bound to the statement at once, as a single
+  columnar batch, so the driver runs them in a single execution. The
+  type of each parameter is inferred from its first non-nil value,
+  and all other values of the same parameter must have the same type.
+  `statement_options` are given to the statement, as in `query/4`.
+
+  ## Examples
+
+      Adbc.Connection.execute_many(conn, "INSERT INTO users VALUES (?, ?)", [
+        {1, "Alice"},
+        {2, "Bob"},
+        {3, nil}
+      ])
+      #=> {:ok, 3}
+
+  """
+  @spec execute_many(t(), binary | reference, [tuple | list], Keyword.t()) ::
+          {:ok, integer()} | {:error, Exception.t()}
+  def execute_many(conn, query, rows, statement_options \\ [])
+      when (is_binary(query) or is_reference(query)) and is_list(rows) and
+             is_list(statement_options) do
+    case rows do
+      [] -> {:ok, 0}
+      _ -> command(conn, {:execute_many, query, rows, statement_options})
+    end
+  end
+
+  @doc """
+  Same as `execute_many/4` but raises an exception on error.
+  """
+  @spec execute_many!(t(), binary | reference, [tuple | list], Keyword.t()) :: integer()
+  def execute_many!(conn, query, rows, statement_options \\ []) do
+    case execute_many(conn, query, rows, statement_options) do
+      {:ok, rows_affected} -> rows_affected
+      {:error, reason} -> raise reason
+    end
+  end
+
   @doc """
   Prepares the given `query`.
   """
@@ -193,10 +303,23 @@ defmodule Adbc.Connection do
   Alternatively, you can pass an `Adbc.StreamResult.t()` (obtained from
   `query_pointer/4`) to efficiently insert query results without materializing the data.
 
+  Rows given as a list of maps (or structs) or tuples can be inserted directly
+  by describing their columns with the `:columns` option. The rows are
+  transposed into columns natively, in a single pass, without building
+  intermediate lists.
+
+  Finally, you can pass any other enumerable, such as a `Stream`, where each
+  element is a batch given as a list of `Adbc.Column`s. The batches are encoded
+  by the calling process as they are enumerated and handed to the driver through
+  a bounded queue, so that large datasets are ingested with constant memory.
+  All batches must have the same columns. If the enumeration raises, the insert
+  is aborted and the exception is re-raised.
+
   ## Arguments
 
     * `conn` - The connection process
-    * `columns_or_stream` - Either a list of `Adbc.Column.t()` or an `Adbc.StreamResult.t()`
+    * `columns_or_stream` - A list of `Adbc.Column.t()`, an `Adbc.StreamResult.t()`
+      or an enumerable of lists of `Adbc.Column.t()`
     * `opts` - Options for the bulk insert operation
 
   ## Options
@@ -221,6 +344,16 @@ defmodule Adbc.Connection do
     * `:temporary` (optional) - If `true`, create a temporary table. Default is `false`.
       Cannot be used with `:catalog` or `:schema`.
 
+    * `:max_batches` (optional) - When given an enumerable of batches, the number
+      of encoded batches that may wait for the driver. Default is `4`.
+      All batches must have the same columns and types as the first one.
+
+    * `:columns` (optional) - When given a list of rows, the `{name, type}` of
+      each column, where `type` is one of the `t:Adbc.Column.data_type/0`.
+      Values of map rows are fetched with the `name` key (missing keys are nil),
+      values of tuple rows are given in the order of the columns. All columns
+      are nullable.
+
   ## Examples
 
       columns = [
@@ -244,6 +377,12 @@ defmodule Adbc.Connection do
       Adbc.Connection.bulk_insert(conn, columns, table: "users", mode: :replace)
       #=> {:ok, 3}
 
+      # Insert rows
+      rows = [%{id: 4, name: "Dave"}, %{id: 5, name: nil}]
+      columns = [id: :s64, name: :string]
+      Adbc.Connection.bulk_insert(conn, rows, columns: columns, table: "users", mode: :append)
+      #=> {:ok, 2}
+
       # Efficiently insert from a query (within query_pointer callback)
       # This is most useful for transferring across databases.
       # Within the same database, you most likely have custom SQL commands,
@@ -252,9 +391,24 @@ defmodule Adbc.Connection do
         Adbc.Connection.bulk_insert(dest_conn, stream, table: "dest_table")
       end)
 
+      # Insert a CSV file one batch of rows at a time
+      File.stream!("users.csv")
+      |> Stream.map(&String.split(String.trim(&1), ","))
+      |> Stream.chunk_every(10_000)
+      |> Stream.map(fn rows ->
+        [
+          Adbc.Column.string(Enum.map(rows, &Enum.at(&1, 0)), name: "id"),
+          Adbc.Column.string(Enum.map(rows, &Enum.at(&1, 1)), name: "name")
+        ]
+      end)
+      |> then(&Adbc.Connection.bulk_insert(conn, &1, table: "users"))
+
   """
-  @spec bulk_insert(t(), [Adbc.Column.t()] | Adbc.StreamResult.t(), Keyword.t()) ::
-          {:ok, non_neg_integer()} | {:error, Exception.t()}
+  @spec bulk_insert(
+          t(),
+          [Adbc.Column.t()] | Adbc.StreamResult.t() | Enumerable.t(),
+          Keyword.t()
+        ) :: {:ok, non_neg_integer()} | {:error, Exception.t()}
   def bulk_insert(conn, columns_or_stream, opts \\ [])
 
   def bulk_insert(conn, %Adbc.StreamResult{} = stream, opts) when is_list(opts) do
@@ -266,16 +420,97 @@ defmodule Adbc.Connection do
     command(conn, {:bulk_insert, stream, statement_options})
   end
 
-  def bulk_insert(conn, columns, opts) when is_list(columns) and is_list(opts) do
+  def bulk_insert(conn, columns_or_rows, opts) when is_list(columns_or_rows) and is_list(opts) do
+    case Keyword.pop(opts, :columns) do
+      {nil, opts} ->
+        command(conn, {:bulk_insert, columns_or_rows, build_ingest_options(opts)})
+
+      {columns, opts} ->
+        columns = record_columns(columns)
+        statement_options = build_ingest_options(opts)
+        command(conn, {:bulk_insert_records, columns_or_rows, columns, statement_options})
+    end
+  end
+
+  def bulk_insert(conn, batches, opts) when is_list(opts) do
+    {max_batches, opts} = Keyword.pop(opts, :max_batches, 4)
     statement_options = build_ingest_options(opts)
-    command(conn, {:bulk_insert, columns, statement_options})
+
+    {:ok, producer, stream_ref} = Adbc.Nif.adbc_arrow_array_stream_queue_new(max_batches)
+
+    # the driver reads the stream while this process enumerates and pushes batches
+    task = Task.async(fn -> command(conn, {:bulk_insert, stream_ref, statement_options}) end)
+
+    pushed =
+      try do
+        push_batches(producer, batches)
+      catch
+        kind, reason ->
+          Adbc.Nif.adbc_arrow_array_stream_queue_finish(producer, "the stream of batches failed")
+          Task.await(task, :infinity)
+          :erlang.raise(kind, reason, __STACKTRACE__)
+      end
+
+    case pushed do
+      :ok ->
+        Adbc.Nif.adbc_arrow_array_stream_queue_finish(producer, nil)
+        Task.await(task, :infinity)
+
+      {:error, reason} ->
+        Adbc.Nif.adbc_arrow_array_stream_queue_finish(producer, reason)
+        Task.await(task, :infinity)
+        {:error, error_to_exception(reason)}
+    end
+  end
+
+  defp record_columns(columns) when is_list(columns) do
+    for column <- columns do
+      case column do
+        {name, type} when is_atom(name) or is_binary(name) ->
+          {name, to_string(name), type}
+
+        other ->
+          raise ArgumentError,
+                "expected :columns to be a list of {name, type} tuples, got: #{inspect(other)}"
+      end
+    end
+  end
+
+  defp push_batches(producer, batches) do
+    ref = make_ref()
+
+    Enum.reduce_while(batches, :ok, fn columns, :ok ->
+      case push_batch(producer, columns, ref) do
+        :ok -> {:cont, :ok}
+        # the driver stopped reading, the command returns why
+        :closed -> {:halt, :ok}
+        {:error, reason} -> {:halt, {:error, reason}}
+      end
+    end)
+  end
+
+  # The queue never blocks the scheduler when full, it tells us
+  # once the driver read a batch or stopped reading instead
+  defp push_batch(producer, columns, ref) do
+    case Adbc.Nif.adbc_arrow_array_stream_queue_push(producer, columns, ref) do
+      {:error, :full} ->
+        receive do
+          {^ref, :ready} -> push_batch(producer, columns, ref)
+        end
+
+      other ->
+        other
+    end
   end
 
   @doc """
   Same as `bulk_insert/3` but raises an exception on error.
   """
-  @spec bulk_insert!(t(), [Adbc.Column.t()] | Adbc.StreamResult.t(), Keyword.t()) ::
-          non_neg_integer()
+  @spec bulk_insert!(
+          t(),
+          [Adbc.Column.t()] | Adbc.StreamResult.t() | Enumerable.t(),
+          Keyword.t()
+        ) :: non_neg_integer()
   def bulk_insert!(conn, columns_or_stream, opts \\ []) do
     case bulk_insert(conn, columns_or_stream, opts) do
       {:ok, rows_affected} -> rows_affected
@@ -353,30 +588,40 @@ defmodule Adbc.Connection do
   The callback function should accept a single argument of type
   `Adbc.StreamResult.t()`. For backwards compatibility, 2-arity
   functions are still supported but deprecated (a warning will be emitted).
+
+  It supports the `:timeout` option of `query/4`, which also bounds the
+  time spent in `fun`.
   """
   def query_pointer(conn, query, params \\ [], fun, statement_options \\ [])
       when (is_binary(query) or is_reference(query)) and is_list(params) and is_function(fun) and
              is_list(statement_options) do
-    stream(conn, {:query, query, params, statement_options}, fn conn, stream_ref, rows_affected ->
-      pointer = Adbc.Nif.adbc_arrow_array_stream_get_pointer(stream_ref)
-
-      if is_function(fun, 2) do
-        IO.warn(
-          "query_pointer/5 callback should be 1-arity (receiving %Adbc.StreamResult{}), 2-arity is deprecated"
-        )
-
-        {:ok, fun.(Adbc.Nif.adbc_arrow_array_stream_get_pointer(stream_ref), rows_affected)}
-      else
-        stream_result = %Adbc.StreamResult{
-          conn: conn,
-          ref: stream_ref,
-          pointer: pointer,
-          num_rows: normalize_rows(rows_affected)
-        }
-
-        {:ok, fun.(stream_result)}
-      end
-    end)
+    {timeout, statement_options} = Keyword.pop(statement_options, :timeout, :infinity)
+
+    stream(
+      conn,
+      {:query, query, params, statement_options},
+      fn conn, stream_ref, rows_affected ->
+        pointer = Adbc.Nif.adbc_arrow_array_stream_get_pointer(stream_ref)
+
+        if is_function(fun, 2) do
+          IO.warn(
+            "query_pointer/5 callback should be 1-arity (receiving %Adbc.StreamResult{}), 2-arity is deprecated"
+          )
+
+          {:ok, fun.(Adbc.Nif.adbc_arrow_array_stream_get_pointer(stream_ref), rows_affected)}
+        else
+          stream_result = %Adbc.StreamResult{
+            conn: conn,
+            ref: stream_ref,
+            pointer: pointer,
+            num_rows: normalize_rows(rows_affected)
+          }
+
+          {:ok, fun.(stream_result)}
+        end
+      end,
+      timeout
+    )
   end
 
   @doc """
@@ -554,14 +799,22 @@ defmodule Adbc.Connection do
     end
   end
 
-  defp stream(conn, command, fun) do
-    case GenServer.call(conn, {:stream, command}, :infinity) do
+  defp stream(conn, command, fun, timeout \\ :infinity) do
+    case GenServer.call(conn, {:stream, command, timeout}, :infinity) do
       {:ok, conn, unlock_ref, stream_ref, rows_affected} ->
-        try do
-          fun.(conn, stream_ref, normalize_rows(rows_affected))
-        after
-          GenServer.cast(conn, {:unlock, unlock_ref})
-        end
+        result =
+          try do
+            fun.(conn, stream_ref, normalize_rows(rows_affected))
+          catch
+            kind, reason ->
+              GenServer.cast(conn, {:unlock, unlock_ref, :ok})
+              :erlang.raise(kind, reason, __STACKTRACE__)
+          end
+
+        # errors reading the results also discard the cached statement
+        status = if match?({:error, _}, result), do: :error, else: :ok
+        GenServer.cast(conn, {:unlock, unlock_ref, status})
+        result
 
       {:error, reason} ->
         {:error, error_to_exception(reason)}
@@ -572,12 +825,28 @@ defmodule Adbc.Connection do
   defp normalize_rows(-1), do: nil
   defp normalize_rows(rows) when is_integer(rows) and rows >= 0, do: rows
 
-  defp stream_results(_conn, reference, num_rows), do: do_stream_results(reference, [], num_rows)
+  defp stream_results(_conn, reference, num_rows, coalesce \\ []) do
+    max_rows = coalesce[:coalesce_max_rows]
+    max_bytes = coalesce[:coalesce_max_bytes]
 
-  defp do_stream_results(reference, acc, num_rows) do
-    case Adbc.Nif.adbc_arrow_array_stream_next(reference) do
+    with :ok <- maybe_prefetch(reference, coalesce[:prefetch]) do
+      do_stream_results(reference, [], num_rows, max_rows, max_bytes)
+    else
+      {:error, reason} -> {:error, error_to_exception(reason)}
+    end
+  end
+
+  defp maybe_prefetch(_reference, nil), do: :ok
+
+  defp maybe_prefetch(reference, depth) when is_integer(depth) and depth > 0,
+    do: Adbc.Nif.adbc_arrow_array_stream_prefetch(reference, depth)
+
+  # Each call drains batches until the stream ends or the budget is reached,
+  # and returns them concatenated into one reference per column
+  defp do_stream_results(reference, acc, num_rows, max_rows, max_bytes) do
+    case Adbc.Nif.adbc_arrow_array_stream_collect(reference, max_rows, max_bytes) do
       {:ok, result} ->
-        do_stream_results(reference, [result | acc], num_rows)
+        do_stream_results(reference, [result | acc], num_rows, max_rows, max_bytes)
 
       :end_of_series ->
         {:ok, %Adbc.Result{data: merge_columns(Enum.reverse(acc)), num_rows: num_rows}}
@@ -587,22 +856,32 @@ defmodule Adbc.Connection do
     end
   end
 
+  # Keeps the batch references of each column in a single list,
+  # they are concatenated natively once the column is materialized
   defp merge_columns(chucked_results) do
-    Enum.zip_with(chucked_results, fn columns ->
-      Enum.reduce(columns, fn column, merged_column ->
-        %{merged_column | data: merged_column.data ++ column.data}
-      end)
+    Enum.zip_with(chucked_results, fn [column | _] = columns ->
+      %{column | data: Enum.flat_map(columns, & &1.data)}
     end)
   end
 
   ## Callbacks
 
   @impl true
-  def init({db, conn}) do
+  def init({db, conn, cache_size}) do
     case GenServer.call(db, {:initialize_connection, conn}, :infinity) do
       {:ok, driver} ->
         Process.put(:adbc_driver, driver)
-        {:ok, %{conn: conn, lock: :none, queue: :queue.new()}}
+
+        state = %{
+          conn: conn,
+          lock: :none,
+          queue: :queue.new(),
+          statements: %{},
+          statement_cache_size: cache_size,
+          statement_clock: 0
+        }
+
+        {:ok, state}
 
       {:error, reason} ->
         {:stop, error_to_exception(reason)}
@@ -610,8 +889,8 @@ defmodule Adbc.Connection do
   end
 
   @impl true
-  def handle_call({:stream, command}, from, state) do
-    state = update_in(state.queue, &:queue.in({:stream, command, from}, &1))
+  def handle_call({:stream, command, timeout}, from, state) do
+    state = update_in(state.queue, &:queue.in({:stream, command, timeout, from}, &1))
     {:noreply, maybe_dequeue(state)}
   end
 
@@ -625,21 +904,65 @@ defmodule Adbc.Connection do
   end
 
   @impl true
-  def handle_cast({:unlock, ref}, %{lock: {ref, stream_ref}} = state) do
+  def handle_cast({:unlock, ref, status}, %{lock: {ref, stream_ref, stmt, timer}} = state) do
     # We could let the GC be the one release it but,
     # since a stream can be a large resource, we release
     # it now and let the GC free the remaining resources.
-    Adbc.Nif.adbc_arrow_array_stream_release(stream_ref)
+    cancel_timer(timer)
+    detached? = release_stream(state, stream_ref, stmt)
     Process.demonitor(ref, [:flush])
+
+    state =
+      cond do
+        detached? -> discard_statement(state, stmt, false)
+        status == :error -> discard_statement(state, stmt, true)
+        true -> state
+      end
+
     {:noreply, maybe_dequeue(%{state | lock: :none})}
   end
 
   @impl true
-  def handle_info({:DOWN, ref, _, _, _}, %{lock: {ref, stream_ref}} = state) do
-    Adbc.Nif.adbc_arrow_array_stream_release(stream_ref)
+  def handle_info({:DOWN, ref, _, _, _}, %{lock: {ref, stream_ref, stmt, timer}} = state) do
+    # the caller is gone, stop the driver from producing more data
+    cancel_timer(timer)
+    cancel(state.conn, stmt)
+    detached? = release_stream(state, stream_ref, stmt)
+    state = discard_statement(state, stmt, not detached?)
     {:noreply, maybe_dequeue(%{state | lock: :none})}
   end
 
+  def handle_info({:timeout, ref}, %{lock: {ref, _stream_ref, stmt, _timer}} = state) do
+    # the caller gets an error from the driver and then unlocks
+    cancel(state.conn, stmt)
+    {:noreply, discard_statement(state, stmt, false)}
+  end
+
+  def handle_info({:timeout, _ref}, state) do
+    {:noreply, state}
+  end
+
+  # A prefetch reader may still be inside the driver when the stream is
+  # released. It then keeps the statement (or the connection) until it
+  # exits, so the statement must not be released or reused in the meantime.
+  defp release_stream(state, stream_ref, stmt) do
+    Adbc.Nif.adbc_arrow_array_stream_release(stream_ref, stmt || state.conn) == {:ok, :detached}
+  end
+
+  defp cancel(conn, nil), do: Adbc.Nif.adbc_connection_cancel(conn)
+  defp cancel(_conn, stmt), do: Adbc.Nif.adbc_statement_cancel(stmt)
+
+  defp cancel_timer(nil), do: :ok
+  defp cancel_timer(timer), do: Process.cancel_timer(timer)
+
+  defp deadline(:infinity), do: :infinity
+
+  defp deadline(timeout) when is_integer(timeout) and timeout >= 0,
+    do: System.monotonic_time(:millisecond) + timeout
+
+  defp remaining(:infinity), do: :infinity
+  defp remaining(deadline), do: max(deadline - System.monotonic_time(:millisecond), 0)
+
   ## Queue helpers
 
   defp maybe_dequeue(%{lock: :none, queue: queue} = state) do
@@ -648,20 +971,30 @@ defmodule Adbc.Connection do
         %{state | queue: queue}
 
       {{:value, {:command, command, from}}, queue} ->
-        result = handle_command(command, state.conn)
+        {result, state} = handle_command(command, state)
         GenServer.reply(from, result)
         maybe_dequeue(%{state | queue: queue})
 
-      {{:value, {:stream, command, from}}, queue} ->
+      {{:value, {:stream, command, timeout, from}}, queue} ->
         {pid, _} = from
+        deadline = deadline(timeout)
+        # the query is cancelled if the caller exits while it runs
+        unlock_ref = Process.monitor(pid)
+
+        {result, state} = handle_stream(command, state, deadline, unlock_ref)
+
+        case result do
+          {:ok, stream_ref, stmt, rows_affected} when is_reference(stream_ref) ->
+            timer =
+              if deadline != :infinity do
+                Process.send_after(self(), {:timeout, unlock_ref}, remaining(deadline))
+              end
 
-        case handle_stream(command, state.conn) do
-          {:ok, stream_ref, rows_affected} when is_reference(stream_ref) ->
-            unlock_ref = Process.monitor(pid)
             GenServer.reply(from, {:ok, self(), unlock_ref, stream_ref, rows_affected})
-            %{state | lock: {unlock_ref, stream_ref}, queue: queue}
+            %{state | lock: {unlock_ref, stream_ref, stmt, timer}, queue: queue}
 
           {:error, error} ->
+            Process.demonitor(unlock_ref, [:flush])
             GenServer.reply(from, {:error, error})
             maybe_dequeue(%{state | queue: queue})
         end
@@ -670,50 +1003,182 @@ defmodule Adbc.Connection do
 
   defp maybe_dequeue(state), do: state
 
-  defp handle_command({:prepare, query}, conn) do
-    with {:ok, stmt} <- create_statement(conn, query),
-         :ok <- Adbc.Nif.adbc_statement_prepare(stmt) do
-      {:ok, stmt}
+  defp handle_command({:prepare, query}, state) do
+    result =
+      with {:ok, stmt} <- create_statement(state.conn, query),
+           :ok <- Adbc.Nif.adbc_statement_prepare(stmt) do
+        {:ok, stmt}
+      end
+
+    {result, state}
+  end
+
+  defp handle_command({:execute_many, query_or_prepared, rows, statement_options}, state) do
+    case ensure_statement(state, query_or_prepared, true, statement_options) do
+      {{:ok, stmt}, state} ->
+        result =
+          with :ok <- Adbc.Nif.adbc_statement_bind_rows(stmt, rows) do
+            Adbc.Helper.await_async(:adbc_statement_execute_async, [stmt])
+          end
+
+        {result, discard_failed_statement(state, stmt, result)}
+
+      {error, state} ->
+        {error, state}
     end
   end
 
-  defp handle_command({:bulk_insert, %Adbc.StreamResult{ref: stream_ref}, options}, conn) do
+  defp handle_command({:bulk_insert, %Adbc.StreamResult{ref: stream_ref}, options}, state) do
+    {ingest_stream(state.conn, stream_ref, options), state}
+  end
+
+  defp handle_command({:bulk_insert, stream_ref, options}, state) when is_reference(stream_ref) do
+    result = ingest_stream(state.conn, stream_ref, options)
+    # the stream is still ours if binding failed
+    Adbc.Nif.adbc_arrow_array_stream_release(stream_ref, nil)
+    {result, state}
+  end
+
+  defp handle_command({:bulk_insert_records, rows, columns, options}, state) do
+    result =
+      with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(state.conn),
+           :ok <- init_statement_options(stmt, options),
+           :ok <- Adbc.Nif.adbc_statement_bind_records(stmt, rows, columns) do
+        Adbc.Helper.await_async(:adbc_statement_execute_async, [stmt])
+      end
+
+    {result, state}
+  end
+
+  defp handle_command({:bulk_insert, columns, options}, state) do
+    result =
+      with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(state.conn),
+           :ok <- init_statement_options(stmt, options),
+           :ok <- Adbc.Nif.adbc_statement_bind(stmt, columns),
+           {:ok, rows_affected} <-
+             Adbc.Helper.await_async(:adbc_statement_execute_async, [stmt]) do
+        {:ok, rows_affected}
+      end
+
+    {result, state}
+  end
+
+  defp ingest_stream(conn, stream_ref, options) do
     with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(conn),
          :ok <- init_statement_options(stmt, options),
          :ok <- Adbc.Nif.adbc_statement_bind_stream(stmt, stream_ref),
-         {:ok, rows_affected} <- Adbc.Nif.adbc_statement_execute(stmt) do
+         {:ok, rows_affected} <-
+           Adbc.Helper.await_async(:adbc_statement_execute_async, [stmt]) do
       {:ok, rows_affected}
     end
   end
 
-  defp handle_command({:bulk_insert, columns, options}, conn) do
-    with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(conn),
-         :ok <- init_statement_options(stmt, options),
-         :ok <- Adbc.Nif.adbc_statement_bind(stmt, columns),
-         {:ok, rows_affected} <- Adbc.Nif.adbc_statement_execute(stmt) do
-      {:ok, rows_affected}
+  defp handle_stream(
+         {:query, query_or_prepared, params, statement_options},
+         state,
+         deadline,
+         caller_ref
+       ) do
+    case ensure_statement(state, query_or_prepared, params != [], statement_options) do
+      {{:ok, stmt}, state} ->
+        result =
+          with :ok <- maybe_bind(stmt, params),
+               {:ok, stream_ref, rows_affected} <-
+                 Adbc.Helper.await_async(
+                   :adbc_statement_execute_query_async,
+                   [stmt],
+                   remaining(deadline),
+                   fn -> Adbc.Nif.adbc_statement_cancel(stmt) end,
+                   caller_ref
+                 ) do
+            {:ok, stream_ref, stmt, rows_affected}
+          end
+
+        {result, discard_failed_statement(state, stmt, result)}
+
+      {error, state} ->
+        {error, state}
     end
   end
 
-  defp handle_stream({:query, query_or_prepared, params, statement_options}, conn) do
-    with {:ok, stmt} <- ensure_statement(conn, query_or_prepared, statement_options),
-         :ok <- maybe_bind(stmt, params) do
-      Adbc.Nif.adbc_statement_execute_query(stmt)
+  defp handle_stream({name, args}, state, _deadline, _caller_ref) do
+    result =
+      with {:ok, stream_ref} <- apply(Adbc.Nif, name, [state.conn | args]) do
+        {:ok, stream_ref, nil, -1}
+      end
+
+    {result, state}
+  end
+
+  defp ensure_statement(state, prepared, _bound?, _statement_options)
+       when is_reference(prepared),
+       do: {{:ok, prepared}, state}
+
+  defp ensure_statement(%{statement_cache_size: 0} = state, query, _bound?, statement_options)
+       when is_binary(query) and is_list(statement_options),
+       do: {create_statement(state.conn, query, statement_options), state}
+
+  # Statements for queries given as strings are prepared once and kept
+  # in a LRU cache, so that the driver only parses and plans them once.
+  #
+  # A statement keeps the parameters of its last bind, so queries with and
+  # without parameters get different statements, as the latter never bind.
+  defp ensure_statement(state, query, bound?, statement_options)
+       when is_binary(query) and is_list(statement_options) do
+    key = {query, statement_options, bound?}
+    clock = state.statement_clock + 1
+    state = %{state | statement_clock: clock}
+
+    case state.statements do
+      %{^key => {stmt, _}} ->
+        {{:ok, stmt}, put_in(state.statements[key], {stmt, clock})}
+
+      %{} ->
+        with {:ok, stmt} <- create_statement(state.conn, query, statement_options) do
+          case Adbc.Nif.adbc_statement_prepare(stmt) do
+            :ok ->
+              state = evict_statements(state, state.statement_cache_size - 1)
+              {{:ok, stmt}, put_in(state.statements[key], {stmt, clock})}
+
+            # the driver cannot prepare it, so executing reports any error
+            {:error, _} ->
+              {{:ok, stmt}, state}
+          end
+        else
+          error -> {error, state}
+        end
     end
   end
 
-  defp handle_stream({name, args}, conn) do
-    with {:ok, stream_ref} <- apply(Adbc.Nif, name, [conn | args]) do
-      {:ok, stream_ref, -1}
+  defp discard_failed_statement(state, stmt, {:error, _}),
+    do: discard_statement(state, stmt, true)
+
+  defp discard_failed_statement(state, _stmt, _result), do: state
+
+  # Statements that failed or were cancelled may be left in any state by
+  # the driver, so they are removed from the cache instead of being reused.
+  # They are only released if no stream of theirs is still being read.
+  defp discard_statement(state, nil, _release?), do: state
+
+  defp discard_statement(state, stmt, release?) do
+    case Enum.find(state.statements, fn {_key, {cached, _}} -> cached == stmt end) do
+      {key, _} ->
+        if release?, do: Adbc.Nif.adbc_statement_release(stmt)
+        %{state | statements: Map.delete(state.statements, key)}
+
+      nil ->
+        state
     end
   end
 
-  defp ensure_statement(conn, query, statement_options)
-       when is_binary(query) and is_list(statement_options),
-       do: create_statement(conn, query, statement_options)
+  defp evict_statements(state, max_size) when map_size(state.statements) <= max_size,
+    do: state
 
-  defp ensure_statement(_conn, prepared, _statement_options) when is_reference(prepared),
-    do: {:ok, prepared}
+  defp evict_statements(state, max_size) do
+    {key, {stmt, _}} = Enum.min_by(state.statements, fn {_key, {_stmt, used}} -> used end)
+    Adbc.Nif.adbc_statement_release(stmt)
+    evict_statements(%{state | statements: Map.delete(state.statements, key)}, max_size)
+  end
 
   defp create_statement(conn, query, statement_options \\ []) when is_list(statement_options) do
     with {:ok, stmt} <- Adbc.Nif.adbc_statement_new(conn),
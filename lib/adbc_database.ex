@@ -132,26 +132,42 @@ defmodule Adbc.Database do
   @impl true
   def init({driver, db}) do
     Process.flag(:trap_exit, true)
-    {:ok, {driver, db}}
+    {:ok, {driver, db, %{}}}
   end
 
+  # Connections are initialized concurrently on the native executor
+  # threads, the reply is sent once the driver is done
   @impl true
-  def handle_call({:initialize_connection, conn_ref}, {pid, _}, {driver, db}) do
-    case Adbc.Nif.adbc_connection_init(conn_ref, db) do
-      :ok ->
-        Process.link(pid)
-        {:reply, {:ok, driver}, {driver, db}}
+  def handle_call({:initialize_connection, conn_ref}, from, {driver, db, pending}) do
+    case Adbc.Helper.start_async(:adbc_connection_init_async, [conn_ref, db]) do
+      {:ok, ref} ->
+        {:noreply, {driver, db, Map.put(pending, ref, from)}}
 
       {:error, reason} ->
-        {:reply, {:error, reason}, {driver, db}}
+        {:reply, {:error, reason}, {driver, db, pending}}
     end
   end
 
-  def handle_call({:option, func, args}, _from, {driver, db}) do
-    {:reply, Adbc.Helper.option(db, func, args), {driver, db}}
+  def handle_call({:option, func, args}, _from, {driver, db, pending}) do
+    {:reply, Adbc.Helper.option(db, func, args), {driver, db, pending}}
   end
 
   @impl true
+  def handle_info({ref, result}, {driver, db, pending}) when is_map_key(pending, ref) do
+    {{pid, _} = from, pending} = Map.pop(pending, ref)
+
+    case result do
+      :ok ->
+        Process.link(pid)
+        GenServer.reply(from, {:ok, driver})
+
+      {:error, reason} ->
+        GenServer.reply(from, {:error, reason})
+    end
+
+    {:noreply, {driver, db, pending}}
+  end
+
   def handle_info(_msg, state), do: {:noreply, state}
 
   defp init_driver(ref, driver, driver_opts) do
@@ -39,6 +39,66 @@ defmodule Adbc.Helper do
     end
   end
 
+  @doc false
+  # Starts one of the `*_async` NIFs on its native thread pool, which
+  # sends `{ref, result}` to the calling process once done.
+  #
+  # Connection setup has its own pool, so it never waits behind queries.
+  def start_async(func, args) do
+    ref = make_ref()
+
+    with :ok <- apply(Adbc.Nif, func, args ++ [ref, async_workers(func)]) do
+      {:ok, ref}
+    end
+  end
+
+  defp async_workers(:adbc_connection_init_async) do
+    Application.get_env(:adbc, :setup_threads, :erlang.system_info(:dirty_io_schedulers))
+  end
+
+  defp async_workers(_func) do
+    Application.get_env(:adbc, :executor_threads, :erlang.system_info(:dirty_io_schedulers))
+  end
+
+  @doc false
+  # Runs one of the `*_async` NIFs and waits for its reply, so that no
+  # dirty scheduler is held while the driver runs.
+  #
+  # If no reply arrives within `timeout`, `on_timeout` is called (to cancel
+  # the operation) and the reply is still awaited. The same happens if the
+  # process monitored by `monitor` goes down first, in which case its
+  # `:DOWN` message is sent back to the caller once the reply arrives.
+  def await_async(
+        func,
+        args,
+        timeout \\ :infinity,
+        on_timeout \\ fn -> :ok end,
+        monitor \\ nil
+      ) do
+    with {:ok, ref} <- start_async(func, args) do
+      receive do
+        {^ref, result} ->
+          result
+
+        {:DOWN, ^monitor, _, _, _} = down ->
+          on_timeout.()
+
+          receive do
+            {^ref, result} ->
+              send(self(), down)
+              result
+          end
+      after
+        timeout ->
+          on_timeout.()
+
+          receive do
+            {^ref, result} -> result
+          end
+      end
+    end
+  end
+
   def option_ok_or_halt(callee, func, args) do
     case option(callee, func, args) do
       :ok -> {:cont, :ok}
@@ -29,6 +29,9 @@ defmodule Adbc.Nif do
 
   def adbc_connection_init(_self, _database), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_connection_init_async(_self, _database, _ref, _workers),
+    do: :erlang.nif_error(:not_loaded)
+
   def adbc_connection_get_info(_self, _info_codes), do: :erlang.nif_error(:not_loaded)
 
   def adbc_connection_get_objects(
@@ -44,8 +47,12 @@ defmodule Adbc.Nif do
 
   def adbc_connection_get_table_types(_self), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_connection_cancel(_self), do: :erlang.nif_error(:not_loaded)
+
   def adbc_statement_new(_self), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_statement_release(_self), do: :erlang.nif_error(:not_loaded)
+
   def adbc_statement_get_option(_self, _type, _key), do: :erlang.nif_error(:not_loaded)
 
   def adbc_statement_set_option(_self, _type, _key, _value), do: :erlang.nif_error(:not_loaded)
@@ -54,19 +61,51 @@ defmodule Adbc.Nif do
 
   def adbc_statement_execute(_self), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_statement_cancel(_self), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_statement_execute_query_async(_self, _ref, _workers),
+    do: :erlang.nif_error(:not_loaded)
+
+  def adbc_statement_execute_async(_self, _ref, _workers), do: :erlang.nif_error(:not_loaded)
+
   def adbc_statement_prepare(_self), do: :erlang.nif_error(:not_loaded)
 
   def adbc_statement_set_sql_query(_self, _query), do: :erlang.nif_error(:not_loaded)
 
   def adbc_statement_bind(_self, _values), do: :erlang.nif_error(:not_loaded)
 
+  def adbc_statement_bind_rows(_self, _rows), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_statement_bind_records(_self, _rows, _columns), do: :erlang.nif_error(:not_loaded)
+
   def adbc_statement_bind_stream(_self, _stream), do: :erlang.nif_error(:not_loaded)
 
   def adbc_arrow_array_stream_get_pointer(_arrow_array_stream), do: :erlang.nif_error(:not_loaded)
 
   def adbc_arrow_array_stream_next(_arrow_array_stream), do: :erlang.nif_error(:not_loaded)
 
-  def adbc_arrow_array_stream_release(_arrow_array_stream), do: :erlang.nif_error(:not_loaded)
+  def adbc_arrow_array_stream_collect(_arrow_array_stream, _max_rows, _max_bytes),
+    do: :erlang.nif_error(:not_loaded)
+
+  def adbc_arrow_array_stream_prefetch(_arrow_array_stream, _depth),
+    do: :erlang.nif_error(:not_loaded)
+
+  def adbc_arrow_array_stream_release(_arrow_array_stream, _owner),
+    do: :erlang.nif_error(:not_loaded)
+
+  def adbc_arrow_array_stream_queue_new(_capacity), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_arrow_array_stream_queue_push(_producer, _columns, _ref),
+    do: :erlang.nif_error(:not_loaded)
+
+  def adbc_arrow_array_stream_queue_finish(_producer, _error),
+    do: :erlang.nif_error(:not_loaded)
 
   def adbc_column_materialize(_data_ref), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_column_materialize(_data_ref, _opts), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_columns_materialize(_data_refs, _opts, _ref), do: :erlang.nif_error(:not_loaded)
+
+  def adbc_column_to_binary(_data_ref), do: :erlang.nif_error(:not_loaded)
 end
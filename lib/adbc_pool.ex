@@ -0,0 +1,252 @@
+defmodule Adbc.Pool do
+  @moduledoc """
+  A pool of `Adbc.Connection` processes sharing one `Adbc.Database`.
+
+  Each `Adbc.Connection` runs one command at a time. A pool starts
+  several of them, so that concurrent callers are spread across
+  connections instead of queueing on a single process. Callers check
+  out an idle connection, use it with the functions in `Adbc.Connection`,
+  and check it back in. The connections keep their own state, such as
+  prepared statements, between checkouts.
+
+  ## Telemetry
+
+  If the `:telemetry` application is available, the pool emits
+  `[:adbc, :pool, :checkout]` once a caller gets a connection, with
+  the `:queue_time` measurement (in `:native` time units) and the
+  `:pool` metadata.
+  """
+
+  use GenServer
+
+  @type t :: GenServer.server()
+
+  @doc """
+  Starts a pool of connections.
+
+  ## Options
+
+    * `:database` (required) - the database process to connect to
+
+    * `:size` - the number of connections. Defaults to
+      `System.schedulers_online/0`
+
+    * `:process_options` - the options to be given to the pool
+      process. See `GenServer.start_link/3` for all options
+
+  All other options are given to every `Adbc.Connection`.
+
+  ## Examples
+
+      children = [
+        {Adbc.Database, driver: :sqlite, process_options: [name: MyApp.DB]},
+        {Adbc.Pool, database: MyApp.DB, size: 8, process_options: [name: MyApp.Pool]}
+      ]
+
+  """
+  def start_link(opts) do
+    unless opts[:database] do
+      raise ArgumentError, ":database option must be specified"
+    end
+
+    {process_options, opts} = Keyword.pop(opts, :process_options, [])
+    {size, opts} = Keyword.pop(opts, :size, System.schedulers_online())
+
+    unless is_integer(size) and size > 0 do
+      raise ArgumentError, ":size must be a positive integer, got: #{inspect(size)}"
+    end
+
+    GenServer.start_link(__MODULE__, {size, opts}, process_options)
+  end
+
+  @doc """
+  Checks out a connection, gives it to `fun` and checks it back in
+  once `fun` returns or raises. Returns the result of `fun`.
+
+  ## Options
+
+    * `:timeout` - how long to wait for an idle connection, in
+      milliseconds. Defaults to `:infinity`
+
+  ## Examples
+
+      Adbc.Pool.checkout(MyApp.Pool, fn conn ->
+        Adbc.Connection.query(conn, "SELECT 123")
+      end)
+
+  """
+  @spec checkout(t(), (Adbc.Connection.t() -> result), Keyword.t()) :: result
+        when result: term()
+  def checkout(pool, fun, opts \\ []) when is_function(fun, 1) and is_list(opts) do
+    timeout = Keyword.get(opts, :timeout, :infinity)
+    token = make_ref()
+
+    {conn, ref} =
+      try do
+        GenServer.call(pool, {:checkout, token, System.monotonic_time()}, timeout)
+      catch
+        :exit, reason ->
+          # the connection may have been given after the call timed out
+          GenServer.cast(pool, {:cancel, token})
+          exit(reason)
+      end
+
+    try do
+      fun.(conn)
+    after
+      GenServer.cast(pool, {:checkin, ref})
+    end
+  end
+
+  @doc """
+  Runs `Adbc.Connection.query/4` on a connection of the pool.
+  """
+  @spec query(t(), binary | reference, [term], Keyword.t()) ::
+          {:ok, Adbc.Result.t()} | {:error, Exception.t()}
+  def query(pool, query, params \\ [], statement_options \\ []) do
+    checkout(pool, &Adbc.Connection.query(&1, query, params, statement_options))
+  end
+
+  @doc """
+  Same as `query/4` but raises an exception on error.
+  """
+  @spec query!(t(), binary | reference, [term], Keyword.t()) :: Adbc.Result.t()
+  def query!(pool, query, params \\ [], statement_options \\ []) do
+    checkout(pool, &Adbc.Connection.query!(&1, query, params, statement_options))
+  end
+
+  @doc """
+  Returns the connections of the pool.
+  """
+  @spec connections(t()) :: [pid()]
+  def connections(pool) do
+    GenServer.call(pool, :connections)
+  end
+
+  ## Callbacks
+
+  @impl true
+  def init({size, opts}) do
+    # the connections are initialized concurrently by the database
+    # and crash the pool if they exit
+    results =
+      1..size
+      |> Task.async_stream(fn _ -> start_connection(opts) end,
+        max_concurrency: size,
+        timeout: :infinity
+      )
+      |> Enum.map(fn {:ok, result} -> result end)
+
+    case Enum.split_with(results, &match?({:ok, _}, &1)) do
+      {started, []} ->
+        conns = Enum.map(started, fn {:ok, conn} -> conn end)
+        Enum.each(conns, &Process.link/1)
+
+        state = %{
+          conns: conns,
+          idle: conns,
+          checked_out: %{},
+          waiting: :queue.new(),
+          telemetry?: Code.ensure_loaded?(:telemetry)
+        }
+
+        {:ok, state}
+
+      {started, [{:error, reason} | _]} ->
+        Enum.each(started, fn {:ok, conn} -> GenServer.stop(conn) end)
+        {:stop, reason}
+    end
+  end
+
+  defp start_connection(opts) do
+    # not linked to the short lived task, the pool links it once started
+    with {:ok, conn} <- Adbc.Connection.start_link(opts) do
+      Process.unlink(conn)
+      {:ok, conn}
+    end
+  end
+
+  @impl true
+  def handle_call({:checkout, token, queued_at}, from, state) do
+    case state.idle do
+      [conn | idle] ->
+        {:noreply, give(%{state | idle: idle}, conn, {from, token, queued_at})}
+
+      [] ->
+        {:noreply, update_in(state.waiting, &:queue.in({from, token, queued_at}, &1))}
+    end
+  end
+
+  def handle_call(:connections, _from, state) do
+    {:reply, state.conns, state}
+  end
+
+  @impl true
+  def handle_cast({:checkin, ref}, state) do
+    {:noreply, checkin(state, ref)}
+  end
+
+  def handle_cast({:cancel, token}, state) do
+    waiting = :queue.filter(fn {_from, waiting, _} -> waiting != token end, state.waiting)
+    state = %{state | waiting: waiting}
+
+    case Enum.find(state.checked_out, fn {_ref, {checked, _conn}} -> checked == token end) do
+      {ref, _} -> {:noreply, checkin(state, ref)}
+      nil -> {:noreply, state}
+    end
+  end
+
+  @impl true
+  def handle_info({:DOWN, ref, _, _, _}, state) do
+    {:noreply, checkin(state, ref)}
+  end
+
+  def handle_info(_msg, state), do: {:noreply, state}
+
+  defp give(state, conn, {{pid, _} = from, token, queued_at}) do
+    ref = Process.monitor(pid)
+    GenServer.reply(from, {conn, ref})
+    telemetry(state, System.monotonic_time() - queued_at)
+    put_in(state.checked_out[ref], {token, conn})
+  end
+
+  defp checkin(state, ref) do
+    case Map.pop(state.checked_out, ref) do
+      {nil, _} ->
+        state
+
+      {{_token, conn}, checked_out} ->
+        Process.demonitor(ref, [:flush])
+        state = %{state | checked_out: checked_out}
+        next_waiting(state, conn)
+    end
+  end
+
+  defp next_waiting(state, conn) do
+    case :queue.out(state.waiting) do
+      {{:value, {{pid, _}, _token, _queued_at} = waiter}, waiting} ->
+        state = %{state | waiting: waiting}
+
+        # skip callers that exited while waiting
+        if Process.alive?(pid) do
+          give(state, conn, waiter)
+        else
+          next_waiting(state, conn)
+        end
+
+      {:empty, _} ->
+        %{state | idle: [conn | state.idle]}
+    end
+  end
+
+  defp telemetry(%{telemetry?: false}, _queue_time), do: :ok
+
+  defp telemetry(%{telemetry?: true}, queue_time) do
+    # :telemetry is an optional dependency of the application using the pool
+    apply(:telemetry, :execute, [
+      [:adbc, :pool, :checkout],
+      %{queue_time: queue_time},
+      %{pool: self()}
+    ])
+  end
+end
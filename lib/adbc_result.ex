@@ -45,12 +45,43 @@ defmodule Adbc.Result do
         }
 
   @doc """
-  `materialize/1` converts the result set's data from reference type to regular Elixir terms.
+  `materialize/2` converts the result set's data from reference type to regular Elixir terms.
+
+  ## Options
+
+    * `:parallel` - when `true`, all the columns and their batches are
+      decoded concurrently on a pool of native threads. The pool has as
+      many threads as dirty CPU schedulers, which can be changed with
+      `config :adbc, :materialize_workers, count` before the first
+      materialization. The calling process waits for the workers without
+      holding a scheduler. When `false`, the columns are decoded one after
+      the other by the calling process, a few rows at a time. Defaults to
+      `true`.
+
+  See `Adbc.Column.materialize/2` for the other supported options.
+
+  Returns `{:error, reason}` if any of the columns cannot be materialized,
+  whether they are materialized in parallel or not.
   """
-  @spec materialize(%Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()}) ::
-          %Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()}
-  def materialize(%Adbc.Result{data: data} = result) when is_list(data) do
-    %{result | data: Enum.map(data, &Adbc.Column.materialize/1)}
+  @spec materialize(
+          %Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()},
+          Keyword.t()
+        ) :: %Adbc.Result{} | {:ok, %Adbc.Result{}} | {:error, String.t()}
+  def materialize(result, opts \\ [])
+
+  def materialize(%Adbc.Result{data: data} = result, opts) when is_list(data) do
+    {parallel, opts} = Keyword.pop(opts, :parallel, true)
+
+    materialized =
+      if parallel do
+        Adbc.Column.materialize_many(data, opts)
+      else
+        Adbc.Column.materialize_each(data, opts)
+      end
+
+    with {:ok, data} <- materialized do
+      %{result | data: data}
+    end
   end
 
   @doc """
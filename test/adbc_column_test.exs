@@ -456,6 +456,105 @@ defmodule Adbc.ColumnTest do
 
       assert Adbc.Column.to_list(run_end_array) == [1, 2, 2]
     end
+
+    test "decodes runs of batches with offsets, nulls and runs across batches" do
+      ree = fn run_ends, values, opts ->
+        Adbc.Column.run_end_encoded(
+          Adbc.Column.s32(run_ends),
+          Adbc.Column.s64(values, nullable: true),
+          Keyword.put(opts, :name, "ree")
+        )
+      end
+
+      # runs of 1000 rows alternating with null runs, large enough to be decoded
+      # in several steps that start in the middle of a run
+      large_run_ends = Enum.map(1..10, &(&1 * 1000))
+      large_values = [3, nil, 2, nil, 4, nil, 6, nil, 8, nil]
+      large = Enum.map(500..9499, &Enum.at(large_values, div(&1, 1000)))
+
+      # the run of 2 continues into the second batch and the run of 3 into the third
+      batches =
+        read_batches([
+          [ree.([3, 5, 6], [1, nil, 2], [])],
+          [ree.([2, 4, 7], [2, nil, 3], offset: 1, length: 5)],
+          [ree.(large_run_ends, large_values, offset: 500, length: 9000)]
+        ])
+
+      expected = [
+        [1, 1, 1, nil, nil, 2],
+        [2, nil, nil, 3, 3],
+        large
+      ]
+
+      decoded =
+        for [column] <- batches do
+          assert %Adbc.Column{type: :s64, data: data} =
+                   Adbc.Column.materialize(column, run_end_encoded: :decode)
+
+          data
+        end
+
+      assert decoded == expected
+
+      # a column over all batches, decoded one batch at a time or concurrently
+      [[column] | _] = batches
+      column = %{column | data: Enum.flat_map(batches, fn [column] -> column.data end)}
+      all = Enum.concat(expected)
+
+      assert %Adbc.Column{data: ^all} =
+               Adbc.Column.materialize(column, run_end_encoded: :decode)
+
+      for parallel <- [true, false] do
+        assert %Adbc.Result{data: [%Adbc.Column{type: :s64, data: ^all}]} =
+                 Adbc.Result.materialize(%Adbc.Result{data: [column]},
+                   run_end_encoded: :decode,
+                   parallel: parallel
+                 )
+      end
+
+      # the runs of the second batch, relative to its offset
+      [_, [second], _] = batches
+      run_ends = <<1::signed-little-64, 3::signed-little-64, 5::signed-little-64>>
+
+      assert %Adbc.Column{
+               type: :run_end_encoded,
+               data: %{run_ends: ^run_ends, values: [2, nil, 3]}
+             } = Adbc.Column.materialize(second, run_end_encoded: :packed)
+
+      assert %Adbc.Column{type: :run_end_encoded, offset: 1, length: 5} =
+               columns = Adbc.Column.materialize(second)
+
+      assert Adbc.Column.to_list(columns) == [2, nil, nil, 3, 3]
+
+      # the runs of all batches, the ones continuing into the next batch
+      # (and into the next step of the large one) are merged
+      ends = [3, 5, 7, 9] ++ Enum.map(0..8, &(511 + &1 * 1000)) ++ [9011]
+      run_ends = for run_end <- ends, into: <<>>, do: <<run_end::signed-little-64>>
+      values = [1, nil, 2, nil, 3, nil, 2, nil, 4, nil, 6, nil, 8, nil]
+
+      assert %Adbc.Column{data: %{run_ends: ^run_ends, values: ^values}} =
+               Adbc.Column.materialize(column, run_end_encoded: :packed)
+
+      for parallel <- [true, false] do
+        assert %Adbc.Result{data: [%Adbc.Column{data: %{run_ends: ^run_ends, values: ^values}}]} =
+                 Adbc.Result.materialize(%Adbc.Result{data: [column]},
+                   run_end_encoded: :packed,
+                   parallel: parallel
+                 )
+      end
+    end
+
+    test "rejects run ends that end before the last row" do
+      {:ok, producer, _stream} = Adbc.Nif.adbc_arrow_array_stream_queue_new(1)
+
+      column =
+        Adbc.Column.run_end_encoded(Adbc.Column.s32([2, 4]), Adbc.Column.s64([1, 2]), length: 6)
+
+      assert {:error, message} =
+               Adbc.Nif.adbc_arrow_array_stream_queue_push(producer, [column], make_ref())
+
+      assert message =~ "Last run end is 4"
+    end
   end
 
   describe "dictionary" do
@@ -477,6 +576,61 @@ defmodule Adbc.ColumnTest do
 
       assert Adbc.Column.to_list(dict) == ["foo", "bar", "foo", "bar", nil, "baz"]
     end
+
+    test "decodes dictionaries shared by batches or replaced mid-stream" do
+      ab = Adbc.Column.string(["a", "b"])
+      cd = Adbc.Column.string(["c", "d"])
+
+      batches =
+        read_batches([
+          [Adbc.Column.dictionary(Adbc.Column.s32([0, 1, 1], nullable: true), ab)],
+          [Adbc.Column.dictionary(Adbc.Column.s32([1, nil, 0], nullable: true), cd)],
+          [Adbc.Column.dictionary(Adbc.Column.s32([1], nullable: true), ab)]
+        ])
+
+      decoded = for [column] <- batches, do: materialize_data(column)
+      assert decoded == [["a", "b", "b"], ["d", nil, "c"], ["b"]]
+
+      # a column over all batches, decoded twice to go through the cached dictionaries
+      [[column] | _] = batches
+      column = %{column | data: Enum.flat_map(batches, fn [column] -> column.data end)}
+
+      for _ <- 1..2 do
+        assert materialize_data(column) == ["a", "b", "b", "d", nil, "c", "b"]
+      end
+    end
+
+    test "decodes dictionaries of batches read after a previous record was freed" do
+      {:ok, producer, stream} = Adbc.Nif.adbc_arrow_array_stream_queue_new(1)
+      ref = make_ref()
+
+      for {keys, values, expected} <- [
+            {[0, 1, 1], ["a", "b"], ["a", "b", "b"]},
+            {[1, 0, 0], ["c", "d"], ["d", "c", "c"]},
+            {[0, 0, 1], ["e", "f"], ["e", "e", "f"]}
+          ] do
+        column = Adbc.Column.dictionary(Adbc.Column.s32(keys), Adbc.Column.string(values))
+        :ok = Adbc.Nif.adbc_arrow_array_stream_queue_push(producer, [column], ref)
+        assert read_and_free(stream) == expected
+      end
+
+      :ok = Adbc.Nif.adbc_arrow_array_stream_queue_finish(producer, nil)
+      assert Adbc.Nif.adbc_arrow_array_stream_collect(stream, 1, nil) == :end_of_series
+    end
+
+    # the record of the batch is garbage collected once this returns,
+    # so the next batch may get the same addresses for its dictionary
+    defp read_and_free(stream) do
+      {:ok, [column]} = Adbc.Nif.adbc_arrow_array_stream_collect(stream, 1, nil)
+      data = materialize_data(column)
+      :erlang.garbage_collect()
+      data
+    end
+
+    defp materialize_data(column) do
+      %Adbc.Column{data: data} = Adbc.Column.materialize(column, decode_dictionary: true)
+      data
+    end
   end
 
   describe "struct" do
@@ -640,4 +794,25 @@ defmodule Adbc.ColumnTest do
              ]
     end
   end
+
+  # Reads `batches` of columns back from a native Arrow stream, as the
+  # batches of a query result, with one list of columns per batch
+  defp read_batches(batches) do
+    {:ok, producer, stream} = Adbc.Nif.adbc_arrow_array_stream_queue_new(length(batches))
+    ref = make_ref()
+
+    for batch <- batches do
+      :ok = Adbc.Nif.adbc_arrow_array_stream_queue_push(producer, batch, ref)
+    end
+
+    :ok = Adbc.Nif.adbc_arrow_array_stream_queue_finish(producer, nil)
+    read_stream(stream)
+  end
+
+  defp read_stream(stream) do
+    case Adbc.Nif.adbc_arrow_array_stream_collect(stream, 1, nil) do
+      {:ok, columns} -> [columns | read_stream(stream)]
+      :end_of_series -> []
+    end
+  end
 end
@@ -400,6 +400,45 @@ defmodule Adbc.ConnectionTest do
                ]
              } = Adbc.Result.materialize(results)
     end
+
+    test "select with zero copy materialization", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      columns = [
+        Adbc.Column.s64([1, 2, 3, 4], name: "id"),
+        Adbc.Column.string(["Alice", nil, "Bob", "Charlie"], name: "name", nullable: true),
+        Adbc.Column.binary([<<1, 2>>, <<3>>, nil, <<4, 5, 6>>], name: "bytes", nullable: true)
+      ]
+
+      assert {:ok, 4} = Connection.bulk_insert(conn, columns, table: "zero_copy")
+
+      {:ok, results} = Connection.query(conn, "SELECT * FROM zero_copy ORDER BY id")
+
+      assert %Adbc.Result{
+               data: [
+                 %Adbc.Column{name: "id", data: [1, 2, 3, 4]},
+                 %Adbc.Column{name: "name", data: ["Alice", nil, "Bob", "Charlie"]},
+                 %Adbc.Column{name: "bytes", data: [<<1, 2>>, <<3>>, nil, <<4, 5, 6>>]}
+               ]
+             } = Adbc.Result.materialize(results, zero_copy: true)
+
+      assert Adbc.Result.materialize(results, zero_copy: true) ==
+               Adbc.Result.materialize(results)
+    end
+
+    test "select with encoded columns materialization", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      {:ok, results} = Connection.query(conn, "SELECT 1 AS num, 'one' AS name")
+
+      for run_end_encoded <- [:columns, :decode, :packed], parallel <- [true, false] do
+        opts = [decode_dictionary: true, run_end_encoded: run_end_encoded, parallel: parallel]
+        assert Adbc.Result.materialize(results, opts) == Adbc.Result.materialize(results)
+      end
+
+      assert_raise ArgumentError, ~r/expected :run_end_encoded to be one of/, fn ->
+        Adbc.Result.materialize(results, run_end_encoded: :unknown)
+      end
+    end
   end
 
   describe "query!" do
@@ -602,6 +641,81 @@ defmodule Adbc.ConnectionTest do
       assert {:ok, ref} = Connection.prepare(conn, "SELECT 123 + ? as num")
       assert is_reference(ref)
     end
+
+    test "rebinds parameters of different types", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      {:ok, ref} = Connection.prepare(conn, "SELECT ? as a, ? as b")
+
+      for params <- [[1, "one"], [2, "two"], [2.5, nil], [3, "three"]] do
+        assert %Adbc.Result{data: [%Adbc.Column{data: [a]}, %Adbc.Column{data: [b]}]} =
+                 conn |> Connection.query!(ref, params) |> Adbc.Result.materialize()
+
+        assert [a, b] == params
+      end
+    end
+
+    test "keeps prepared statements usable after a failed bind", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      {:ok, ref} = Connection.prepare(conn, "SELECT ? as a")
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: [1]}]} =
+               conn |> Connection.query!(ref, [1]) |> Adbc.Result.materialize()
+
+      assert {:error, _} = Connection.query(conn, ref, [%{}])
+
+      for value <- ["two", 3, "four"] do
+        assert %Adbc.Result{data: [%Adbc.Column{data: [^value]}]} =
+                 conn |> Connection.query!(ref, [value]) |> Adbc.Result.materialize()
+      end
+    end
+
+    test "reuses cached statements for the same query", %{db: db} do
+      conn = start_supervised!({Connection, database: db, statement_cache_size: 2})
+
+      for query <- ["SELECT 1 + ? as num", "SELECT 2 + ? as num", "SELECT 3 + ? as num"],
+          value <- [10, 20],
+          _ <- 1..2 do
+        base = query |> binary_part(7, 1) |> String.to_integer()
+
+        assert %Adbc.Result{data: [%Adbc.Column{data: [result]}]} =
+                 conn |> Connection.query!(query, [value]) |> Adbc.Result.materialize()
+
+        assert result == base + value
+      end
+
+      assert %{statements: statements} = :sys.get_state(conn)
+      assert map_size(statements) == 2
+    end
+
+    test "does not reuse the parameters of cached statements", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: [1]}]} =
+               conn |> Connection.query!("SELECT ? AS a", [1]) |> Adbc.Result.materialize()
+
+      # unbound parameters are NULL in SQLite
+      assert %Adbc.Result{data: [%Adbc.Column{data: [nil]}]} =
+               conn |> Connection.query!("SELECT ? AS a", []) |> Adbc.Result.materialize()
+    end
+
+    test "does not cache statements that failed", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      # prepared fine, but overflows once executed
+      assert {:error, %Adbc.Error{}} =
+               Connection.query(conn, "SELECT abs(-9223372036854775808) AS num")
+
+      assert %{statements: statements} = :sys.get_state(conn)
+      assert statements == %{}
+      run_anything(conn)
+    end
+
+    test "does not cache statements with a cache size of zero", %{db: db} do
+      conn = start_supervised!({Connection, database: db, statement_cache_size: 0})
+      assert {:ok, %Adbc.Result{}} = Connection.query(conn, "SELECT 1 as num")
+      assert %{statements: statements} = :sys.get_state(conn)
+      assert statements == %{}
+    end
   end
 
   describe "query_pointer" do
@@ -669,6 +783,28 @@ defmodule Adbc.ConnectionTest do
       run_anything(conn)
     end
 
+    test "timeouts while reading the results keep the connection usable", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      assert {:ok, :slept} =
+               Connection.query_pointer(
+                 conn,
+                 "SELECT 1",
+                 fn _ ->
+                   Process.sleep(100)
+                   :slept
+                 end,
+                 timeout: 10
+               )
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: [1]}]} =
+               conn
+               |> Connection.query!("SELECT 1 AS num", [], timeout: 5_000)
+               |> Adbc.Result.materialize()
+
+      run_anything(conn)
+    end
+
     test "commands that error do not lock", %{db: db} do
       conn = start_supervised!({Connection, database: db})
       {:error, %Adbc.Error{}} = Connection.query(conn, "NOT VALID SQL")
@@ -681,6 +817,68 @@ defmodule Adbc.ConnectionTest do
     end
   end
 
+  describe "execute_many" do
+    test "inserts all rows with a single execution", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      Connection.query!(conn, "CREATE TABLE users (id INTEGER, name TEXT, score REAL)")
+
+      rows = [{1, "Alice", 1.5}, {2, nil, 2}, [3, "Charlie", nil]]
+      assert {:ok, _} = Connection.execute_many(conn, "INSERT INTO users VALUES (?, ?, ?)", rows)
+
+      map =
+        conn
+        |> Connection.query!("SELECT * FROM users ORDER BY id")
+        |> Adbc.Result.materialize()
+        |> Adbc.Result.to_map()
+
+      assert map["id"] == [1, 2, 3]
+      assert map["name"] == ["Alice", nil, "Charlie"]
+      assert map["score"] == [1.5, 2.0, nil]
+    end
+
+    test "errors on mismatched rows", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      Connection.query!(conn, "CREATE TABLE users (id INTEGER, name TEXT)")
+      query = "INSERT INTO users VALUES (?, ?)"
+
+      assert {:error, %ArgumentError{} = error} =
+               Connection.execute_many(conn, query, [{1, "Alice"}, {"two", "Bob"}])
+
+      assert Exception.message(error) =~
+               "Expected all values of parameter 1 to have the same type"
+
+      assert {:error, %ArgumentError{} = error} =
+               Connection.execute_many(conn, query, [{1, "Alice"}, {2}])
+
+      assert Exception.message(error) =~ "Expected all rows to be tuples or lists of 2 parameters"
+
+      assert Connection.execute_many!(conn, query, [{1, "Alice"}]) >= 0
+    end
+
+    test "keeps the statement usable after a bad batch", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      Connection.query!(conn, "CREATE TABLE users (id INTEGER, name TEXT)")
+      {:ok, ref} = Connection.prepare(conn, "INSERT INTO users VALUES (?, ?)")
+
+      assert Connection.execute_many!(conn, ref, [{1, "Alice"}, {2, "Bob"}]) >= 0
+
+      # new types for the bound buffers, failing halfway through
+      assert {:error, %ArgumentError{}} =
+               Connection.execute_many(conn, ref, [{"three", 3}, {"four", 4}, {5, "five"}])
+
+      assert {:ok, _} = Connection.query(conn, ref, [6, "Frank"])
+
+      map =
+        conn
+        |> Connection.query!("SELECT * FROM users ORDER BY id")
+        |> Adbc.Result.materialize()
+        |> Adbc.Result.to_map()
+
+      assert map["id"] == [1, 2, 6]
+      assert map["name"] == ["Alice", "Bob", "Frank"]
+    end
+  end
+
   describe "bulk_insert" do
     test "creates table and inserts data", %{db: db} do
       conn = start_supervised!({Connection, database: db})
@@ -1030,5 +1228,112 @@ defmodule Adbc.ConnectionTest do
       assert map["id"] == [10, 20, 30]
       assert map["code"] == ["X", "Y", "Z"]
     end
+
+    test "inserts an enumerable of batches", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      batches =
+        1..100
+        |> Stream.chunk_every(7)
+        |> Stream.map(fn ids ->
+          [
+            Adbc.Column.s64(ids, name: "id"),
+            Adbc.Column.string(Enum.map(ids, &"user #{&1}"), name: "name")
+          ]
+        end)
+
+      assert {:ok, 100} =
+               Connection.bulk_insert(conn, batches, table: "users", max_batches: 2)
+
+      map =
+        conn
+        |> Connection.query!("SELECT * FROM users ORDER BY id")
+        |> Adbc.Result.materialize()
+        |> Adbc.Result.to_map()
+
+      assert map["id"] == Enum.to_list(1..100)
+      assert List.last(map["name"]) == "user 100"
+    end
+
+    test "inserts rows of maps and tuples", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      columns = [id: :s64, name: :string, score: :f64, active: :boolean, born: :date32]
+
+      rows = [
+        %{id: 1, name: "Alice", score: 1.5, active: true, born: ~D[2000-01-01]},
+        %{id: 2, score: 2}
+      ]
+
+      assert {:ok, 2} = Connection.bulk_insert(conn, rows, columns: columns, table: "users")
+
+      rows = [{3, "Charlie", nil, false, nil}]
+
+      assert {:ok, 1} =
+               Connection.bulk_insert(conn, rows,
+                 columns: columns,
+                 table: "users",
+                 mode: :append
+               )
+
+      map =
+        conn
+        |> Connection.query!("SELECT id, name, score FROM users ORDER BY id")
+        |> Adbc.Result.materialize()
+        |> Adbc.Result.to_map()
+
+      assert map["id"] == [1, 2, 3]
+      assert map["name"] == ["Alice", nil, "Charlie"]
+      assert map["score"] == [1.5, 2.0, nil]
+    end
+
+    test "errors on rows not matching their columns", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+      columns = [id: :s64, name: :string]
+
+      assert {:error, %ArgumentError{} = error} =
+               Connection.bulk_insert(conn, [%{id: "one"}], columns: columns, table: "users")
+
+      assert Exception.message(error) =~ "Expected values of column `id` to be of type `s64`"
+
+      assert {:error, %ArgumentError{} = error} =
+               Connection.bulk_insert(conn, [{1}], columns: columns, table: "users")
+
+      assert Exception.message(error) =~ "Expected rows to be maps or tuples of 2 elements"
+    end
+
+    test "errors on batches with another schema than the first one", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      batches = [
+        [Adbc.Column.s64([1, 2], name: "id")],
+        [Adbc.Column.string(["three"], name: "id")]
+      ]
+
+      assert {:error, %ArgumentError{} = error} =
+               Connection.bulk_insert(conn, batches, table: "users", max_batches: 1)
+
+      assert Exception.message(error) =~
+               "expected all batches of the stream to have the same schema, field `id`"
+
+      # the connection is still usable
+      assert {:ok, %Adbc.Result{}} = Connection.query(conn, "SELECT 1")
+    end
+
+    test "aborts the insert when the enumerable raises", %{db: db} do
+      conn = start_supervised!({Connection, database: db})
+
+      batches =
+        Stream.map([1, 2], fn
+          1 -> [Adbc.Column.s64([1], name: "id")]
+          2 -> raise "oops"
+        end)
+
+      assert_raise RuntimeError, "oops", fn ->
+        Connection.bulk_insert(conn, batches, table: "users")
+      end
+
+      # the connection is still usable
+      assert {:ok, %Adbc.Result{}} = Connection.query(conn, "SELECT 1")
+    end
   end
 end
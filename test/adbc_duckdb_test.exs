@@ -176,6 +176,95 @@ defmodule Adbc.DuckDBTest do
            } = Adbc.Result.materialize(results)
   end
 
+  @tag :unix
+  test "decimal128 in lists", %{conn: conn} do
+    d1 = Decimal.new("1.5")
+    d2 = Decimal.new("-2.0")
+
+    results =
+      Connection.query!(conn, "SELECT [1.5::DECIMAL(4,1), NULL, -2.0::DECIMAL(4,1)] AS d")
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{
+                 name: "d",
+                 type: :list,
+                 data: [
+                   %Adbc.Column{
+                     type: {:decimal, 128, 4, 1},
+                     data: [^d1, nil, ^d2]
+                   }
+                 ]
+               }
+             ]
+           } = Adbc.Result.materialize(results)
+  end
+
+  test "materialize nested lists in steps", %{conn: conn} do
+    # the first row alone has more items than a step decodes on a normal scheduler
+    query = """
+    SELECT CASE WHEN x = 0 THEN range(100000) ELSE range(x % 200) END AS l
+    FROM range(5000) t(x) ORDER BY x
+    """
+
+    %Adbc.Result{data: [column]} = Connection.query!(conn, query)
+    assert %Adbc.Column{type: :list} = column = Adbc.Column.materialize(column)
+
+    expected = [
+      Enum.to_list(0..99_999) | Enum.map(1..4999, &Enum.to_list(0..(rem(&1, 200) - 1)//1))
+    ]
+
+    assert Adbc.Column.to_list(column) == expected
+  end
+
+  test "enums decoded across batches", %{conn: conn} do
+    Connection.query!(conn, "CREATE TYPE mood AS ENUM ('sad', 'ok', 'happy')")
+
+    # several batches, all with the same dictionary
+    query = """
+    SELECT CASE WHEN x % 7 = 0 THEN NULL ELSE (['sad', 'ok', 'happy'])[1 + x % 3] END::mood AS m
+    FROM range(5000) t(x) ORDER BY x
+    """
+
+    %Adbc.Result{data: [column]} = Connection.query!(conn, query)
+
+    expected =
+      Enum.map(0..4999, fn
+        x when rem(x, 7) == 0 -> nil
+        x -> Enum.at(["sad", "ok", "happy"], rem(x, 3))
+      end)
+
+    for _ <- 1..2 do
+      assert %Adbc.Column{type: :string, data: ^expected} =
+               Adbc.Column.materialize(column, decode_dictionary: true)
+    end
+  end
+
+  test "sparse unions", %{conn: conn} do
+    # each member is used by interleaved rows, and "flag" only by a few rows far apart
+    type = "UNION(num BIGINT, str VARCHAR, flag BOOLEAN)"
+
+    query = """
+    SELECT CASE
+      WHEN x % 100 = 1 THEN union_value(flag := true)::#{type}
+      WHEN x % 3 = 0 THEN union_value(num := x)::#{type}
+      ELSE union_value(str := 's' || x)::#{type}
+    END AS u
+    FROM range(5000) t(x) ORDER BY x
+    """
+
+    %Adbc.Result{data: [column]} = Connection.query!(conn, query)
+
+    expected =
+      Enum.map(0..4999, fn
+        x when rem(x, 100) == 1 -> %{"flag" => [true]}
+        x when rem(x, 3) == 0 -> %{"num" => [x]}
+        x -> %{"str" => ["s#{x}"]}
+      end)
+
+    assert %Adbc.Column{type: :sparse_union, data: ^expected} = Adbc.Column.materialize(column)
+  end
+
   @tag :unix
   @describetag driver: :duckdb
   test "array handling", %{conn: conn} do
@@ -0,0 +1,91 @@
+defmodule Adbc.PoolTest do
+  use ExUnit.Case, async: true
+
+  alias Adbc.Pool
+
+  setup do
+    %{db: start_supervised!({Adbc.Database, driver: :sqlite, uri: ":memory:"})}
+  end
+
+  test "starts the given number of connections", %{db: db} do
+    pool = start_supervised!({Pool, database: db, size: 3})
+    conns = Pool.connections(pool)
+    assert length(conns) == 3
+    assert Enum.all?(conns, &Process.alive?/1)
+  end
+
+  test "errors with invalid connection options", %{db: db} do
+    Process.flag(:trap_exit, true)
+    assert {:error, %Adbc.Error{}} = Pool.start_link(database: db, size: 2, who_knows: 123)
+  end
+
+  test "runs queries", %{db: db} do
+    pool = start_supervised!({Pool, database: db, size: 2})
+
+    assert %Adbc.Result{data: [%Adbc.Column{data: [123]}]} =
+             pool |> Pool.query!("SELECT 123 AS num") |> Adbc.Result.materialize()
+
+    assert {:ok, %Adbc.Result{}} = Pool.query(pool, "SELECT ? AS num", [456])
+  end
+
+  test "checks out different connections concurrently", %{db: db} do
+    pool = start_supervised!({Pool, database: db, size: 2})
+    parent = self()
+
+    tasks =
+      for _ <- 1..2 do
+        Task.async(fn ->
+          Pool.checkout(pool, fn conn ->
+            send(parent, {:checked_out, conn})
+            assert_receive :continue
+            conn
+          end)
+        end)
+      end
+
+    assert_receive {:checked_out, conn1}
+    assert_receive {:checked_out, conn2}
+    assert conn1 != conn2
+
+    Enum.each(tasks, &send(&1.pid, :continue))
+    assert Enum.sort(Task.await_many(tasks)) == Enum.sort([conn1, conn2])
+  end
+
+  test "queues callers until a connection is checked in", %{db: db} do
+    pool = start_supervised!({Pool, database: db, size: 1})
+    parent = self()
+
+    task =
+      Task.async(fn ->
+        Pool.checkout(pool, fn conn ->
+          send(parent, {:checked_out, conn})
+          assert_receive :continue
+        end)
+      end)
+
+    assert_receive {:checked_out, conn}
+
+    assert catch_exit(Pool.checkout(pool, & &1, timeout: 50))
+    send(task.pid, :continue)
+    Task.await(task)
+
+    assert Pool.checkout(pool, & &1) == conn
+  end
+
+  test "checks in the connection of callers that exit", %{db: db} do
+    pool = start_supervised!({Pool, database: db, size: 1})
+    parent = self()
+
+    child =
+      spawn(fn ->
+        Pool.checkout(pool, fn _ ->
+          send(parent, :ready)
+          Process.sleep(:infinity)
+        end)
+      end)
+
+    assert_receive :ready
+    Process.exit(child, :kill)
+    assert {:ok, %Adbc.Result{}} = Pool.query(pool, "SELECT 1")
+  end
+end
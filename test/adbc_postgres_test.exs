@@ -32,6 +32,28 @@ defmodule Adbc.PostgresTest do
            } = Adbc.Result.materialize(results)
   end
 
+  test "get_info with values of several types", %{conn: conn} do
+    # a dense union where an integer value is between the string ones
+    assert {:ok, results} = Connection.get_info(conn, [0, 103, 1])
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "info_name", data: [0, 103, 1]},
+               %Adbc.Column{
+                 name: "info_value",
+                 type: :dense_union,
+                 data: [
+                   %{"string_value" => ["PostgreSQL"]},
+                   %{"int64_value" => [1_001_000]},
+                   %{"string_value" => [version]}
+                 ]
+               }
+             ]
+           } = Adbc.Result.materialize(results)
+
+    assert is_binary(version)
+  end
+
   test "list responses", %{conn: conn} do
     assert {:ok, results} = Connection.query(conn, "SELECT ARRAY[1, 2, 3] as num")
 
@@ -80,6 +102,24 @@ defmodule Adbc.PostgresTest do
            } = Adbc.Result.materialize(results)
   end
 
+  test "list responses as plain lists", %{conn: conn} do
+    assert {:ok, results} =
+             Connection.query(
+               conn,
+               "SELECT * FROM (VALUES (ARRAY[1, 2, 3, null, 5]), (NULL), ('{}'::int[])) t(num)"
+             )
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{
+                 name: "num",
+                 type: {:list, %Adbc.Column{type: :s32}},
+                 data: [[1, 2, 3, nil, 5], nil, []]
+               }
+             ]
+           } = Adbc.Result.materialize(results, plain_lists: true)
+  end
+
   test "nested list responses with null", %{conn: conn} do
     # import adbc_driver_postgresql
     # import adbc_driver_manager
@@ -225,6 +265,52 @@ defmodule Adbc.PostgresTest do
            } = Adbc.Result.materialize(results)
   end
 
+  test "select with temporal types before the unix epoch", %{conn: conn} do
+    query = """
+    select
+      '1969-12-31T23:59:59.999999'::timestamp as datetime,
+      '1900-02-28T01:02:03.5'::timestamp as datetime_1900,
+      '1600-03-01'::date as date
+    """
+
+    assert {:ok, results} = Connection.query(conn, query)
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "datetime", data: [~N[1969-12-31 23:59:59.999999]]},
+               %Adbc.Column{name: "datetime_1900", data: [~N[1900-02-28 01:02:03.500000]]},
+               %Adbc.Column{name: "date", data: [~D[1600-03-01]]}
+             ]
+           } = Adbc.Result.materialize(results)
+  end
+
+  test "bulk insert temporal types before the unix epoch", %{conn: conn} do
+    dates = [~D[1600-03-01], ~D[1969-12-31], ~D[2023-03-01]]
+
+    datetimes = [
+      ~N[1900-02-28 01:02:03.500000],
+      ~N[1969-12-31 23:59:59.999999],
+      ~N[2023-03-01 10:23:45.123456]
+    ]
+
+    columns = [
+      Adbc.Column.date32(dates, name: "date"),
+      Adbc.Column.timestamp(datetimes, :microseconds, nil, name: "datetime")
+    ]
+
+    assert {:ok, 3} =
+             Connection.bulk_insert(conn, columns, table: "temporal_before_epoch", temporary: true)
+
+    assert {:ok, results} = Connection.query(conn, "SELECT * FROM temporal_before_epoch")
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "date", data: ^dates},
+               %Adbc.Column{name: "datetime", data: ^datetimes}
+             ]
+           } = Adbc.Result.materialize(results)
+  end
+
   test "inf/-inf/nan", %{db: _, conn: conn} do
     assert {:ok, results} =
              Adbc.Connection.query(
@@ -367,4 +453,77 @@ defmodule Adbc.PostgresTest do
              ]
            } = result |> Adbc.Result.materialize()
   end
+
+  describe "cancellation" do
+    test "timeouts cancel a running query", %{conn: conn} do
+      started = System.monotonic_time(:millisecond)
+
+      assert {:error, %Adbc.Error{} = error} =
+               Connection.query(conn, "SELECT pg_sleep(30)", [], timeout: 100)
+
+      assert Exception.message(error) =~ "canceling statement"
+      assert System.monotonic_time(:millisecond) - started < 10_000
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: [1]}]} =
+               conn |> Connection.query!("SELECT 1 AS num") |> Adbc.Result.materialize()
+    end
+
+    test "callers exiting while the query runs cancel it", %{db: db, conn: conn} do
+      monitor = start_supervised!({Connection, database: db}, id: :monitor)
+      child = spawn(fn -> Connection.query(conn, "SELECT pg_sleep(30) AS adbc_exit_run") end)
+
+      wait_for_active(monitor, "adbc_exit_run", 1)
+      Process.exit(child, :kill)
+      wait_for_active(monitor, "adbc_exit_run", 0)
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: [1]}]} =
+               conn |> Connection.query!("SELECT 1 AS num") |> Adbc.Result.materialize()
+    end
+
+    test "callers exiting while reading the results cancel the query", %{db: db, conn: conn} do
+      monitor = start_supervised!({Connection, database: db}, id: :monitor)
+      parent = self()
+
+      child =
+        spawn(fn ->
+          Connection.query_pointer(
+            conn,
+            "SELECT x AS adbc_exit_read FROM generate_series(1, 1000000000) x",
+            fn _ ->
+              send(parent, :ready)
+              Process.sleep(:infinity)
+            end
+          )
+        end)
+
+      assert_receive :ready, 10_000
+      Process.exit(child, :kill)
+      wait_for_active(monitor, "adbc_exit_read", 0)
+
+      assert %Adbc.Result{data: [%Adbc.Column{data: [1]}]} =
+               conn |> Connection.query!("SELECT 1 AS num") |> Adbc.Result.materialize()
+    end
+
+    defp wait_for_active(conn, tag, expected, attempts \\ 200) do
+      query = """
+      SELECT count(*) AS n FROM pg_stat_activity
+      WHERE state = 'active' AND pid <> pg_backend_pid() AND query LIKE $1
+      """
+
+      %Adbc.Result{data: [%Adbc.Column{data: [count]}]} =
+        conn |> Connection.query!(query, ["%#{tag}%"]) |> Adbc.Result.materialize()
+
+      cond do
+        count == expected ->
+          :ok
+
+        attempts > 0 ->
+          Process.sleep(50)
+          wait_for_active(conn, tag, expected, attempts - 1)
+
+        true ->
+          flunk("expected #{expected} active queries tagged #{tag}, got: #{count}")
+      end
+    end
+  end
 end
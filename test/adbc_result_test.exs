@@ -87,6 +87,14 @@ defmodule Adbc.ResultTest do
            ]
   end
 
+  test "materialize errors are returned with and without parallel" do
+    column = %Adbc.Column{name: "x", type: :s64, nullable: true, metadata: nil, data: nil}
+    result = %Result{data: [%{column | data: make_ref()}, %{column | data: make_ref()}]}
+
+    assert {:error, "cannot access Nif resource"} = Result.materialize(result)
+    assert {:error, "cannot access Nif resource"} = Result.materialize(result, parallel: false)
+  end
+
   test "to_map with list views" do
     assert %{
              "start_time" => [~N[2024-05-31 12:00:00], ~N[2024-05-31 12:30:00]],
@@ -410,4 +410,191 @@ defmodule Adbc.SQLiteTest do
              ]
            } = Adbc.Result.materialize(results)
   end
+
+  test "to_binary", %{conn: conn} do
+    columns = [
+      Adbc.Column.s64([1, 2, 3], name: "i"),
+      Adbc.Column.f64([1.5, nil, -2.0], name: "f", nullable: true),
+      Adbc.Column.string(["a", "b", "c"], name: "s")
+    ]
+
+    assert {:ok, 3} = Connection.bulk_insert(conn, columns, table: "to_binary")
+    assert {:ok, %Adbc.Result{data: [i, f, s]}} = Connection.query(conn, "SELECT * FROM to_binary")
+
+    assert Adbc.Column.to_binary(i) ==
+             {<<1::64-signed-little, 2::64-signed-little, 3::64-signed-little>>, nil}
+
+    assert {<<1.5::float-64-little, _::binary-size(8), -2.0::float-64-little>>, <<0b101>>} =
+             Adbc.Column.to_binary(f)
+
+    assert_raise ArgumentError, ~r/only fixed width types are supported/, fn ->
+      Adbc.Column.to_binary(s)
+    end
+
+    assert_raise ArgumentError, fn ->
+      i |> Adbc.Column.materialize() |> Adbc.Column.to_binary()
+    end
+  end
+
+  test "insert packed binaries", %{conn: conn} do
+    columns = [
+      Adbc.Column.s32(<<1::32-signed-little, -2::32-signed-little, 3::32-signed-little>>,
+        name: "i"
+      ),
+      Adbc.Column.f64(<<1.5::float-64-little, 0::64, -2.0::float-64-little>>,
+        name: "f",
+        validity: <<0b101>>
+      )
+    ]
+
+    assert {:ok, 3} = Connection.bulk_insert(conn, columns, table: "packed")
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "i", data: [1, -2, 3]},
+               %Adbc.Column{name: "f", data: [1.5, nil, -2.0]}
+             ]
+           } = Connection.query!(conn, "SELECT * FROM packed") |> Adbc.Result.materialize()
+
+    assert_raise ArgumentError, fn -> Adbc.Column.s32(<<1, 2, 3>>) end
+    assert_raise ArgumentError, fn -> Adbc.Column.s32(<<0::64>>, validity: <<>>) end
+  end
+
+  test "insert packed sub-binaries that are not aligned", %{conn: conn} do
+    # large enough to be a reference-counted binary, sliced one byte in
+    packed = for x <- 1..100, into: <<0>>, do: <<x::64-signed-little>>
+    <<_, ints::binary>> = packed
+    packed = for x <- 1..100, into: <<0, 0, 0>>, do: <<x / 2::float-64-little>>
+    floats = binary_part(packed, 3, 800)
+
+    columns = [Adbc.Column.s64(ints, name: "i"), Adbc.Column.f64(floats, name: "f")]
+    assert {:ok, 100} = Connection.bulk_insert(conn, columns, table: "unaligned")
+
+    expected_floats = Enum.map(1..100, &(&1 / 2))
+
+    assert %Adbc.Result{
+             data: [
+               %Adbc.Column{name: "i", data: ints},
+               %Adbc.Column{name: "f", data: ^expected_floats}
+             ]
+           } = Connection.query!(conn, "SELECT * FROM unaligned") |> Adbc.Result.materialize()
+
+    assert ints == Enum.to_list(1..100)
+  end
+
+  test "materialize a column with multiple batches", %{conn: conn} do
+    query = """
+    WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 2500)
+    SELECT x FROM c
+    """
+
+    assert {:ok, %Adbc.Result{data: [%Adbc.Column{data: refs}]} = result} =
+             Connection.query(conn, query, [], coalesce_max_rows: 1)
+
+    assert length(refs) > 1
+    assert Enum.all?(refs, &is_reference/1)
+
+    assert %Adbc.Result{data: [%Adbc.Column{data: data}]} = Adbc.Result.materialize(result)
+    assert data == Enum.to_list(1..2500)
+  end
+
+  test "materialize a large batch in steps", %{conn: conn} do
+    query = """
+    WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 20000)
+    SELECT x, 'row ' || x AS s FROM c
+    """
+
+    assert {:ok, %Adbc.Result{data: [%Adbc.Column{data: [_]}, _]} = result} =
+             Connection.query(conn, query, [], "adbc.sqlite.query.batch_rows": 20000)
+
+    # the parallel path decodes whole batches on the native workers instead
+    assert %Adbc.Result{data: [%Adbc.Column{data: xs}, %Adbc.Column{data: ss}]} =
+             Adbc.Result.materialize(result, parallel: false)
+
+    assert xs == Enum.to_list(1..20000)
+    assert ss == Enum.map(1..20000, &"row #{&1}")
+  end
+
+  test "materialize columns in parallel", %{conn: conn} do
+    query = """
+    WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 5000)
+    SELECT x, x * 0.5 AS f, 'row ' || x AS s, CAST(x AS BLOB) AS b FROM c
+    """
+
+    result = Connection.query!(conn, query, [], coalesce_max_rows: 1)
+    assert [%Adbc.Column{data: [_, _ | _]} | _] = result.data
+
+    parallel = Adbc.Result.materialize(result, parallel: true)
+    assert parallel == Adbc.Result.materialize(result, parallel: false)
+
+    assert [%Adbc.Column{data: xs}, %Adbc.Column{data: fs}, %Adbc.Column{data: ss}, _] =
+             parallel.data
+
+    assert xs == Enum.to_list(1..5000)
+    assert fs == Enum.map(1..5000, &(&1 * 0.5))
+    assert ss == Enum.map(1..5000, &"row #{&1}")
+  end
+
+  test "coalesce batches into one reference per column", %{conn: conn} do
+    query = """
+    WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 2500)
+    SELECT x, 'row ' || x AS s, CASE WHEN x % 3 = 0 THEN NULL ELSE x * 0.5 END AS f FROM c
+    """
+
+    assert {:ok, %Adbc.Result{data: [%Adbc.Column{data: [_]}, %Adbc.Column{data: [_]}, _]} =
+              result} = Connection.query(conn, query)
+
+    assert %Adbc.Result{data: [%Adbc.Column{data: xs}, %Adbc.Column{data: ss}, f]} =
+             Adbc.Result.materialize(result)
+
+    assert %Adbc.Column{data: fs} = f
+
+    assert xs == Enum.to_list(1..2500)
+    assert ss == Enum.map(1..2500, &"row #{&1}")
+    assert fs == Enum.map(1..2500, &if(rem(&1, 3) == 0, do: nil, else: &1 * 0.5))
+
+    assert {:ok, %Adbc.Result{data: [%Adbc.Column{data: chunks} | _]} = chunked} =
+             Connection.query(conn, query, [], coalesce_max_rows: 1500)
+
+    assert length(chunks) == 2
+    assert Adbc.Result.materialize(chunked) == Adbc.Result.materialize(result)
+  end
+
+  test "prefetch batches on a native thread", %{conn: conn} do
+    query = """
+    WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 5000)
+    SELECT x, 'row ' || x AS s FROM c
+    """
+
+    expected = conn |> Connection.query!(query) |> Adbc.Result.materialize()
+
+    for depth <- [1, 4] do
+      assert {:ok, result} = Connection.query(conn, query, [], prefetch: depth)
+      assert Adbc.Result.materialize(result) == expected
+
+      assert {:ok, result} =
+               Connection.query(conn, query, [], prefetch: depth, coalesce_max_rows: 1)
+
+      assert [%Adbc.Column{data: [_, _ | _]} | _] = result.data
+      assert Adbc.Result.materialize(result) == expected
+    end
+  end
+
+  test "execute queries on the native executor threads", %{conn: conn} do
+    query = """
+    WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c WHERE x < 1000)
+    SELECT sum(x) AS total FROM c
+    """
+
+    dirty_io = :erlang.system_info(:dirty_io_schedulers)
+
+    results =
+      1..(dirty_io * 2)
+      |> Task.async_stream(fn _ -> Connection.query!(conn, query) end,
+        max_concurrency: dirty_io * 2
+      )
+      |> Enum.map(fn {:ok, result} -> Adbc.Result.materialize(result) end)
+
+    assert Enum.all?(results, &match?(%Adbc.Result{data: [%Adbc.Column{data: [500_500]}]}, &1))
+  end
 end